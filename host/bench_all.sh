@@ -0,0 +1,29 @@
+#!/usr/bin/env bash
+# Builds the three host geometries and benchmarks every visualizer on each.
+#
+#   host/bench_all.sh [frames] [csv|json] > bench.csv
+#
+# CSV output is one table (header printed once); JSON output is one object per line,
+# one per geometry.
+
+set -euo pipefail
+cd "$(dirname "$0")/.."
+
+FRAMES="${1:-300}"
+FORMAT="${2:-csv}"
+ENVS=(native_22x22 native_32x48 native)
+
+header=1
+for env in "${ENVS[@]}"; do
+	pio run -c platformio_native.ini -e "$env" -s >&2
+	out=$(".pio/build_native/$env/program" --bench --frames "$FRAMES" --format "$FORMAT")
+	if [[ "$FORMAT" == "csv" && $header -eq 0 ]]; then
+		out=$(tail -n +2 <<< "$out")
+	fi
+	if [[ "$FORMAT" == "json" ]]; then
+		tr -d '\n' <<< "$out"; echo
+	else
+		echo "$out"
+	fi
+	header=0
+done
@@ -0,0 +1,269 @@
+#pragma once
+
+//========================================================================================
+// Host audio replay: WAV file as an fl::audio::IInput (hostRunner --wav / --audio-csv)
+//
+// WavInput stands in for the I2S microphone. It hands out 512-sample blocks, the same
+// size the DMA delivers, each stamped with the time its last sample would have arrived.
+// A block is released only once the virtual clock has reached that stamp. So
+// readAll() in captureAudioFrame() drains 1..N blocks per render frame exactly as it
+// does on the device at the same fps, and filterSample(), getFFT() and the bus
+// updates all run unmodified.
+//
+// --wav alone feeds audio to any mode (render, bench, golden). --audio-csv runs the
+// audio pipeline without rendering and writes one row per frame: rms_norm, per-bus
+// norm/avResponse/newBeat (avResponse through the same dynamicPulse/leadResponse
+// calls CK6 uses), lead.energy and fft_norm[], plus µs spent per drained block, and
+// mel[]/chroma[] when --set cx27=1.
+//
+// Levels differ from the ICS-43434 path, so gate/floor params may need --set. The
+// file restarts for every visualizer, but bus/auto-gain state carries over, so record
+// --wav golden baselines with the same --only selection you check with.
+//========================================================================================
+
+#include "fl/audio/input.h"
+
+namespace hostRunner {
+
+	class WavInput : public fl::audio::IInput {
+	public:
+		static const uint16_t BLOCK_SAMPLES = 512;   // matches the I2S DMA block
+
+		// Loads a PCM16/PCM24/float32 WAV; keeps channel 0 (mic is on Left)
+		bool open(const char* path, fl::string* err) {
+			FILE* f = fopen(path, "rb");
+			if (!f) { if (err) *err = "cannot open wav"; return false; }
+
+			char riff[12];
+			if (fread(riff, 1, 12, f) != 12 || memcmp(riff, "RIFF", 4) || memcmp(riff + 8, "WAVE", 4)) {
+				fclose(f);
+				if (err) *err = "not a RIFF/WAVE file";
+				return false;
+			}
+
+			uint16_t format = 0, channels = 0, bits = 0;
+			bool haveFmt = false;
+			char id[4];
+			uint32_t size = 0;
+
+			while (fread(id, 1, 4, f) == 4 && fread(&size, 4, 1, f) == 1) {
+				if (!memcmp(id, "fmt ", 4)) {
+					uint8_t fmt[40] = {};
+					const size_t n = size < sizeof(fmt) ? size : sizeof(fmt);
+					if (fread(fmt, 1, n, f) != n) break;
+					if (size > n) fseek(f, size - n, SEEK_CUR);
+					memcpy(&format, fmt + 0, 2);
+					memcpy(&channels, fmt + 2, 2);
+					memcpy(&mSampleRate, fmt + 4, 4);
+					memcpy(&bits, fmt + 14, 2);
+					if (format == 0xFFFE && n >= 26) memcpy(&format, fmt + 24, 2);  // WAVE_FORMAT_EXTENSIBLE
+					haveFmt = true;
+				} else if (!memcmp(id, "data", 4) && haveFmt) {
+					const bool ok = readData(f, size, format, channels, bits);
+					fclose(f);
+					if (!ok && err) *err = "unsupported wav encoding (need PCM16, PCM24 or float32)";
+					return ok;
+				} else {
+					fseek(f, size + (size & 1), SEEK_CUR);
+				}
+			}
+
+			fclose(f);
+			if (err) *err = "wav has no fmt/data chunk";
+			return false;
+		}
+
+		uint32_t sampleRate() const { return mSampleRate; }
+		uint32_t durationMs() const { return mSampleRate ? (uint32_t)((uint64_t)mPcm.size() * 1000 / mSampleRate) : 0; }
+		bool finished() const { return mPos + BLOCK_SAMPLES > mPcm.size(); }
+		uint32_t blocksRead() const { return mBlock; }
+
+		// Back to the first block; the stream re-anchors on the clock at the next read()
+		void rewind() {
+			mPos = 0;
+			mBlock = 0;
+			mAnchored = false;
+		}
+
+		//=================================================================
+		// fl::audio::IInput
+
+		void start() override { mStarted = true; }
+		void stop() override { mStarted = false; }
+
+		bool error(fl::string* msg = nullptr) override {
+			(void)msg;
+			return false;
+		}
+
+		fl::audio::Sample read() override {
+			if (!mStarted || finished()) return fl::audio::Sample();
+			if (!mAnchored) {
+				mStartMs = clockMs;
+				mAnchored = true;
+			}
+
+			// Timestamp = when the block's last sample would have been captured
+			const uint32_t ts = mStartMs +
+				(uint32_t)((uint64_t)(mBlock + 1) * BLOCK_SAMPLES * 1000 / mSampleRate);
+			if (ts > clockMs) return fl::audio::Sample();
+
+			fl::span<const int16_t> block(&mPcm[mPos], BLOCK_SAMPLES);
+			mPos += BLOCK_SAMPLES;
+			mBlock++;
+			return fl::audio::Sample(block, ts);
+		}
+
+	private:
+		bool readData(FILE* f, uint32_t size, uint16_t format, uint16_t channels, uint16_t bits) {
+			if (channels == 0 || mSampleRate == 0) return false;
+			const uint16_t bytesPerSample = bits / 8;
+			const bool pcm16 = (format == 1 && bits == 16);
+			const bool pcm24 = (format == 1 && bits == 24);
+			const bool f32 = (format == 3 && bits == 32);
+			if (!pcm16 && !pcm24 && !f32) return false;
+
+			const uint32_t frameBytes = bytesPerSample * channels;
+			std::vector<uint8_t> raw(size);
+			const size_t got = fread(raw.data(), 1, size, f);
+			const size_t frames = got / frameBytes;
+
+			mPcm.resize(frames);
+			for (size_t i = 0; i < frames; i++) {
+				const uint8_t* s = &raw[i * frameBytes];
+				int32_t v = 0;
+				if (pcm16) {
+					int16_t x; memcpy(&x, s, 2); v = x;
+				} else if (pcm24) {
+					v = (int32_t)((uint32_t)s[0] << 8 | (uint32_t)s[1] << 16 | (uint32_t)s[2] << 24) >> 16;
+				} else {
+					float x; memcpy(&x, s, 4);
+					v = (int32_t)lrintf(fl::clamp(x, -1.0f, 1.0f) * 32767.0f);
+				}
+				mPcm[i] = (int16_t)fl::clamp(v, (int32_t)-32768, (int32_t)32767);
+			}
+			return true;
+		}
+
+		std::vector<int16_t> mPcm;
+		size_t mPos = 0;
+		uint32_t mBlock = 0;
+		uint32_t mSampleRate = 0;
+		uint32_t mStartMs = 0;
+		bool mStarted = false;
+		bool mAnchored = false;
+	};
+
+	fl::shared_ptr<WavInput> wavInput;
+
+	// Declared in hostCore.hpp; each visualizer hears the file from the top
+	void rewindWav() {
+		if (wavInput) wavInput->rewind();
+	}
+
+	//=====================================================================
+
+	// Swaps the (absent) I2S source for the WAV file; config follows its sample rate
+	bool attachWav(const Options& opt) {
+		wavInput = fl::make_shared<WavInput>();
+		fl::string err;
+		if (!wavInput->open(opt.wavPath, &err)) {
+			fprintf(stderr, "%s: %s\n", opt.wavPath, err.c_str());
+			wavInput.reset();
+			return false;
+		}
+
+		myAudio::config = fl::audio::Config::CreateIcs43434(
+			I2S_WS_PIN, I2S_SD_PIN, I2S_CLK_PIN,
+			fl::audio::AudioChannel::Left,
+			wavInput->sampleRate()
+		);
+
+		wavInput->start();
+		myAudio::audioSource = wavInput;
+		myAudio::audioInputInitialized = true;
+		return true;
+	}
+
+	//=====================================================================
+
+	int runAudioReplay(const Options& opt) {
+
+		FILE* csv = fopen(opt.audioCsvPath, "w");
+		if (!csv) {
+			fprintf(stderr, "cannot open %s\n", opt.audioCsvPath);
+			return 2;
+		}
+
+		myAudio::binConfig& b = maxBins ? myAudio::bin32 : myAudio::bin16;
+		b.busBased = true;
+
+		fprintf(csv, "frame,t_ms,blocks,us,valid,gate,rms_norm");
+		const char* busNames[3] = { "busA", "busB", "busC" };
+		for (const char* n : busNames) fprintf(csv, ",%s_norm,%s_avResponse,%s_newBeat", n, n, n);
+		fprintf(csv, ",lead_energy,onset,bpm,beat_phase,next_beat_ms");
+		for (uint8_t i = 0; i < b.NUM_FFT_BINS; i++) fprintf(csv, ",fft_norm_%u", i);
+		if (melChroma) {
+			for (uint8_t i = 0; i < myAudio::NUM_MEL_BANDS; i++) fprintf(csv, ",mel_%u", i);
+			for (uint8_t i = 0; i < myAudio::NUM_CHROMA; i++) fprintf(csv, ",chroma_%u", i);
+		}
+		fprintf(csv, "\n");
+
+		uint64_t totalUs = 0;
+		uint32_t totalBlocks = 0;
+		uint32_t maxUs = 0;
+		uint32_t beats[3] = { 0, 0, 0 };
+		uint32_t f = 0;
+
+		// Until the file runs dry (or --frames, when given)
+		for (; opt.framesSet ? f < opt.frames : !wavInput->finished(); f++) {
+
+			setFrameClock(opt, f);
+
+			const auto t0 = std::chrono::steady_clock::now();
+			const myAudio::AudioFrame& frame = myAudio::updateAudioFrame(b);
+			const auto t1 = std::chrono::steady_clock::now();
+			const uint32_t us = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+
+			const uint16_t blocks = myAudio::lastAudioBuffersDrained;
+			totalUs += us;
+			totalBlocks += blocks;
+			if (us > maxUs) maxUs = us;
+
+			// Same response shaping CK6 applies to its bus copies
+			myAudio::Bus a = frame.busA, bb = frame.busB, c = frame.busC;
+			a.avResponse = myAudio::dynamicPulse(frame.busA, frame.timestamp);
+			bb.avResponse = myAudio::dynamicPulse(frame.busB, frame.timestamp);
+			c.avResponse = myAudio::leadResponse();
+			const myAudio::Bus* buses[3] = { &a, &bb, &c };
+
+			fprintf(csv, "%u,%u,%u,%u,%u,%u,%.5f", (unsigned)f, (unsigned)clockMs, blocks, (unsigned)us,
+				frame.valid ? 1 : 0, myAudio::noiseGateOpen ? 1 : 0, frame.rms_norm);
+			for (uint8_t i = 0; i < 3; i++) {
+				fprintf(csv, ",%.5f,%.5f,%u", buses[i]->norm, buses[i]->avResponse, buses[i]->newBeat ? 1 : 0);
+				if (buses[i]->newBeat) beats[i]++;
+			}
+			fprintf(csv, ",%.5f,%.5f,%.2f,%.4f,%u", myAudio::lead.energy, frame.onset, frame.bpm,
+				frame.beatPhase, (unsigned)frame.nextBeatMs);
+			for (uint8_t i = 0; i < b.NUM_FFT_BINS; i++) fprintf(csv, ",%.4f", frame.fft_norm[i]);
+			if (melChroma) {
+				for (uint8_t i = 0; i < myAudio::NUM_MEL_BANDS; i++) fprintf(csv, ",%.4f", frame.mel[i]);
+				for (uint8_t i = 0; i < myAudio::NUM_CHROMA; i++) fprintf(csv, ",%.3f", frame.chroma[i]);
+			}
+			fprintf(csv, "\n");
+		}
+
+		fclose(csv);
+
+		printf("# wav=%s sr=%u duration_ms=%u frames=%u fps=%.1f blocks=%u\n",
+			opt.wavPath, (unsigned)wavInput->sampleRate(), (unsigned)wavInput->durationMs(),
+			(unsigned)f, opt.fps, (unsigned)totalBlocks);
+		printf("# us_per_frame mean=%.1f max=%u | us_per_block mean=%.1f\n",
+			f ? (double)totalUs / f : 0.0, (unsigned)maxUs,
+			totalBlocks ? (double)totalUs / totalBlocks : 0.0);
+		printf("# beats busA=%u busB=%u busC=%u\n", (unsigned)beats[0], (unsigned)beats[1], (unsigned)beats[2]);
+		printf("# tempo bpm=%.2f confidence=%.2f\n", myAudio::tempo.bpm, myAudio::tempo.confidence);
+		return 0;
+	}
+
+} // namespace hostRunner
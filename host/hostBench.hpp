@@ -0,0 +1,107 @@
+#pragma once
+
+//========================================================================================
+// Host benchmark: per-visualizer frame-time statistics (hostRunner --bench)
+//
+// Walks VISUALIZER_PARAM_LOOKUP in table order, renders each visualizer from a fresh
+// init for --warmup + --frames frames on the virtual clock, and reports wall-clock µs
+// per frame (mean/p50/p99/max over the measured frames; first_us is the init frame).
+// Geometry is fixed per build — host/bench_all.sh runs the 22x22, 32x48 and 48x64 envs.
+//
+// Host µs are not device µs: use them to rank modes and catch regressions, and
+// scale against one on-device PROFILE_REPORT() to estimate the P4/S3 budget.
+//========================================================================================
+
+#include <algorithm>
+
+namespace hostRunner {
+
+	struct FrameStats {
+		uint32_t frames = 0;
+		uint32_t firstUs = 0;
+		double meanUs = 0.0;
+		uint32_t p50Us = 0;
+		uint32_t p99Us = 0;
+		uint32_t maxUs = 0;
+	};
+
+	//=====================================================================
+
+	uint32_t percentile(const std::vector<uint32_t>& sorted, float p) {
+		if (sorted.empty()) return 0;
+		size_t rank = (size_t)ceilf(p * sorted.size());
+		if (rank < 1) rank = 1;
+		if (rank > sorted.size()) rank = sorted.size();
+		return sorted[rank - 1];
+	}
+
+	FrameStats benchVisualizer(const Options& opt, const VisualizerRef& v) {
+
+		beginVisualizer(v);
+
+		FrameStats stats;
+		std::vector<uint32_t> samples;
+		samples.reserve(opt.frames);
+
+		const uint32_t total = opt.warmup + opt.frames;
+		for (uint32_t f = 0; f < total; f++) {
+			setFrameClock(opt, f);
+			const uint32_t us = renderFrame();
+			if (f == 0) stats.firstUs = us;
+			if (f >= opt.warmup) samples.push_back(us);
+		}
+
+		stats.frames = (uint32_t)samples.size();
+		if (samples.empty()) return stats;
+
+		uint64_t sum = 0;
+		for (uint32_t us : samples) sum += us;
+		std::sort(samples.begin(), samples.end());
+
+		stats.meanUs = (double)sum / samples.size();
+		stats.p50Us = percentile(samples, 0.50f);
+		stats.p99Us = percentile(samples, 0.99f);
+		stats.maxUs = samples.back();
+		return stats;
+	}
+
+	//=====================================================================
+
+	int runBench(const Options& opt) {
+
+		const std::vector<VisualizerRef> visualizers = listVisualizers();
+		const bool json = (opt.format == OutputFormat::JSON);
+		bool first = true;
+
+		if (json) {
+			printf("{\"geometry\":\"%dx%d\",\"leds\":%d,\"frames\":%u,\"warmup\":%u,\"results\":[\n",
+				HEIGHT, WIDTH, NUM_LEDS, (unsigned)opt.frames, (unsigned)opt.warmup);
+		} else {
+			printf("geometry,visualizer,program,mode,frames,first_us,mean_us,p50_us,p99_us,max_us,fps_mean\n");
+		}
+
+		for (const auto& v : visualizers) {
+			if (opt.only && !strstr(v.name, opt.only)) continue;
+
+			const FrameStats s = benchVisualizer(opt, v);
+			const double fps = s.meanUs > 0.0 ? 1e6 / s.meanUs : 0.0;
+
+			if (json) {
+				printf("%s  {\"visualizer\":\"%s\",\"program\":%u,\"mode\":%u,\"frames\":%u,\"first_us\":%u,"
+					"\"mean_us\":%.1f,\"p50_us\":%u,\"p99_us\":%u,\"max_us\":%u,\"fps_mean\":%.1f}",
+					first ? "" : ",\n", v.name, v.program, v.mode, (unsigned)s.frames, (unsigned)s.firstUs,
+					s.meanUs, (unsigned)s.p50Us, (unsigned)s.p99Us, (unsigned)s.maxUs, fps);
+			} else {
+				printf("%dx%d,%s,%u,%u,%u,%u,%.1f,%u,%u,%u,%.1f\n",
+					HEIGHT, WIDTH, v.name, v.program, v.mode, (unsigned)s.frames, (unsigned)s.firstUs,
+					s.meanUs, (unsigned)s.p50Us, (unsigned)s.p99Us, (unsigned)s.maxUs, fps);
+			}
+			first = false;
+			fflush(stdout);
+		}
+
+		if (json) printf("\n]}\n");
+		return 0;
+	}
+
+} // namespace hostRunner
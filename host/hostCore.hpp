@@ -0,0 +1,271 @@
+#pragma once
+
+//========================================================================================
+// Host runner core: virtual clock, options and the setup()/frame helpers shared by
+// every runner mode (see hostRunner.hpp for usage)
+//========================================================================================
+
+#include <chrono>
+#include <vector>
+#include <utility>
+#include "platforms/stub/time_stub.h"
+
+namespace hostRunner {
+
+	// Virtual clock behind millis()/micros()/fl::millis() for the whole build
+	uint32_t clockMs = 0;
+
+	struct VisualizerRef {
+		const char* name;
+		uint8_t program;
+		uint8_t mode;
+	};
+
+	enum class OutputFormat : uint8_t { CSV, JSON };
+
+	struct Options {
+		uint8_t program = 6;
+		uint8_t mode = 0;
+		uint32_t frames = 60;
+		bool framesSet = false;
+		uint32_t warmup = 10;
+		float fps = 60.0f;
+		uint32_t startMs = 0;
+		const char* dumpPath = nullptr;
+		const char* diffPath = nullptr;
+		const char* only = nullptr;
+		const char* goldenRecordDir = nullptr;
+		const char* goldenCheckDir = nullptr;
+		const char* wavPath = nullptr;
+		const char* audioCsvPath = nullptr;
+		uint32_t goldenEvery = 10;
+		float psnrMin = 0.0f;
+		uint8_t tolerance = 0;
+		uint16_t fftHop = 0;	// 0 = keep myAudio::fftHopSamples
+		bool timing = false;
+		bool bench = false;
+		bool noiseBench = false;
+		bool fftCheck = false;
+		bool pcmBench = false;
+		bool verbose = false;
+		OutputFormat format = OutputFormat::CSV;
+		std::vector<std::pair<String, float>> params;
+	};
+
+	//=====================================================================
+
+	void printUsage() {
+		fprintf(stderr,
+			"usage: program [--program N] [--mode N] [--frames N] [--fps F] [--start-ms N]\n"
+			"               [--set id=value]... [--dump file.rgb] [--diff file.rgb]\n"
+			"               [--tolerance N] [--time] [--verbose]\n"
+			"       program --bench [--frames N] [--warmup N] [--format csv|json] [--only text]\n"
+			"       program --golden-record DIR | --golden-check DIR [--frames N] [--golden-every N]\n"
+			"               [--psnr-min dB] [--only text]\n"
+			"       program --noise-bench [--frames N]\n"
+			"       program --fft-check [--frames N]\n"
+			"       program --pcm-bench [--frames N]\n"
+			"       program --wav file.wav --audio-csv out.csv [--frames N] [--fps F] [--fft-hop N]\n"
+			"               [--set id=value]...\n");
+	}
+
+	bool parseArgs(int argc, char** argv, Options& opt) {
+		for (int i = 1; i < argc; i++) {
+			const char* a = argv[i];
+			const bool hasValue = (i + 1 < argc);
+			if (!strcmp(a, "--program") && hasValue) { opt.program = (uint8_t)atoi(argv[++i]); }
+			else if (!strcmp(a, "--mode") && hasValue) { opt.mode = (uint8_t)atoi(argv[++i]); }
+			else if (!strcmp(a, "--frames") && hasValue) { opt.frames = (uint32_t)strtoul(argv[++i], nullptr, 10); opt.framesSet = true; }
+			else if (!strcmp(a, "--warmup") && hasValue) { opt.warmup = (uint32_t)strtoul(argv[++i], nullptr, 10); }
+			else if (!strcmp(a, "--fps") && hasValue) { opt.fps = strtof(argv[++i], nullptr); }
+			else if (!strcmp(a, "--start-ms") && hasValue) { opt.startMs = (uint32_t)strtoul(argv[++i], nullptr, 10); }
+			else if (!strcmp(a, "--dump") && hasValue) { opt.dumpPath = argv[++i]; }
+			else if (!strcmp(a, "--diff") && hasValue) { opt.diffPath = argv[++i]; }
+			else if (!strcmp(a, "--only") && hasValue) { opt.only = argv[++i]; }
+			else if (!strcmp(a, "--golden-record") && hasValue) { opt.goldenRecordDir = argv[++i]; }
+			else if (!strcmp(a, "--golden-check") && hasValue) { opt.goldenCheckDir = argv[++i]; }
+			else if (!strcmp(a, "--golden-every") && hasValue) { opt.goldenEvery = (uint32_t)strtoul(argv[++i], nullptr, 10); }
+			else if (!strcmp(a, "--psnr-min") && hasValue) { opt.psnrMin = strtof(argv[++i], nullptr); }
+			else if (!strcmp(a, "--wav") && hasValue) { opt.wavPath = argv[++i]; }
+			else if (!strcmp(a, "--audio-csv") && hasValue) { opt.audioCsvPath = argv[++i]; }
+			else if (!strcmp(a, "--fft-hop") && hasValue) { opt.fftHop = (uint16_t)atoi(argv[++i]); }
+			else if (!strcmp(a, "--tolerance") && hasValue) { opt.tolerance = (uint8_t)atoi(argv[++i]); }
+			else if (!strcmp(a, "--time")) { opt.timing = true; }
+			else if (!strcmp(a, "--bench")) { opt.bench = true; }
+			else if (!strcmp(a, "--noise-bench")) { opt.noiseBench = true; }
+			else if (!strcmp(a, "--fft-check")) { opt.fftCheck = true; }
+			else if (!strcmp(a, "--pcm-bench")) { opt.pcmBench = true; }
+			else if (!strcmp(a, "--verbose")) { opt.verbose = true; }
+			else if (!strcmp(a, "--format") && hasValue) {
+				const char* f = argv[++i];
+				if (!strcmp(f, "csv")) opt.format = OutputFormat::CSV;
+				else if (!strcmp(f, "json")) opt.format = OutputFormat::JSON;
+				else { fprintf(stderr, "unknown --format '%s'\n", f); return false; }
+			}
+			else if (!strcmp(a, "--set") && hasValue) {
+				const char* kv = argv[++i];
+				const char* eq = strchr(kv, '=');
+				if (!eq) { fprintf(stderr, "--set expects id=value, got '%s'\n", kv); return false; }
+				opt.params.emplace_back(String(std::string(kv, eq - kv)), strtof(eq + 1, nullptr));
+			}
+			else { fprintf(stderr, "unknown or incomplete option '%s'\n", a); return false; }
+		}
+		if (opt.fps <= 0.0f || opt.program >= PROGRAM_COUNT || opt.goldenEvery == 0) {
+			fprintf(stderr, "invalid --fps, --program or --golden-every\n");
+			return false;
+		}
+		if (opt.audioCsvPath && !opt.wavPath) {
+			fprintf(stderr, "--audio-csv needs --wav\n");
+			return false;
+		}
+		return true;
+	}
+
+	//=====================================================================
+
+	// Parameter state as it stood after --set, restored before each visualizer so
+	// results don't depend on which visualizers ran before (or on --only)
+	struct ParamSnapshot {
+		#define X(type, parameter, def) type parameter;
+		PARAMETER_TABLE
+		#undef X
+		bool layers[9];
+	};
+
+	ParamSnapshot baseParams;
+
+	void snapshotParameters(ParamSnapshot& s) {
+		#define X(type, parameter, def) s.parameter = c##parameter;
+		PARAMETER_TABLE
+		#undef X
+		bool* layers[9] = { &Layer1, &Layer2, &Layer3, &Layer4, &Layer5, &Layer6, &Layer7, &Layer8, &Layer9 };
+		for (uint8_t i = 0; i < 9; i++) s.layers[i] = *layers[i];
+	}
+
+	void restoreParameters(const ParamSnapshot& s) {
+		#define X(type, parameter, def) c##parameter = s.parameter;
+		PARAMETER_TABLE
+		#undef X
+		bool* layers[9] = { &Layer1, &Layer2, &Layer3, &Layer4, &Layer5, &Layer6, &Layer7, &Layer8, &Layer9 };
+		for (uint8_t i = 0; i < 9; i++) *layers[i] = s.layers[i];
+	}
+
+	void rewindWav();   // hostAudioReplay.hpp
+
+	//=====================================================================
+	// Mirrors the parts of setup() that matter for rendering
+
+	void applyParams(const Options& opt) {
+		for (const auto& p : opt.params) {
+			if (p.first.startsWith("cx")) {
+				processCheckbox(p.first, p.second != 0.0f);
+			} else {
+				processNumber(p.first, p.second);
+			}
+		}
+	}
+
+	void hostSetup(const Options& opt) {
+
+		setTimeProvider([]() { return clockMs; });
+
+		debug = opt.verbose;
+		Serial.setMuted(!opt.verbose);
+
+		// Same registration as setup(); nothing is ever shown, frameBytes() reads the canvas
+		FastLED.addLeds<WS2812B, PIN0, RGB>(outputStage::frame, NUM_LEDS);
+		FastLED.setBrightness(255);
+		FastLED.clear();
+
+		BRIGHTNESS = 255;
+		displayOn = true;
+
+		// No I2S on the host: audio programs see an invalid (silent) frame unless
+		// --wav attaches a file source (run() does that after setup)
+		myAudio::initAudioProcessing();
+		if (opt.fftHop) myAudio::fftHopSamples = opt.fftHop;
+
+		PROGRAM = opt.program;
+		MODE = opt.mode;
+
+		applyParams(opt);
+		snapshotParameters(baseParams);
+	}
+
+	//=====================================================================
+
+	void setFrameClock(const Options& opt, uint32_t frame) {
+		clockMs = opt.startMs + (uint32_t)(frame * (1000.0f / opt.fps));
+	}
+
+	// Renders one frame at virtual time clockMs; returns wall-clock µs spent
+	uint32_t renderFrame() {
+		const auto t0 = std::chrono::steady_clock::now();
+		runProgram();
+		const auto t1 = std::chrono::steady_clock::now();
+		return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+	}
+
+	//=====================================================================
+
+	// Lookup entries are grouped by program with modes in *_MODES order, so an
+	// entry's mode is its position within its program group. (Resolving by name
+	// would miss "audiotest-flbeatdetection", which is mode "latencytest".)
+	std::vector<VisualizerRef> listVisualizers() {
+		std::vector<VisualizerRef> out;
+		const int count = sizeof(VISUALIZER_PARAM_LOOKUP) / sizeof(VisualizerParamEntry);
+
+		for (int i = 0; i < count; i++) {
+			const char* name = VISUALIZER_PARAM_LOOKUP[i].visualizerName;
+			const char* dash = strchr(name, '-');
+			const size_t progLen = dash ? (size_t)(dash - name) : strlen(name);
+
+			int program = -1;
+			for (int p = 0; p < PROGRAM_COUNT; p++) {
+				const char* progName = PROGRAM_NAMES[p];
+				if (strlen(progName) == progLen && !strncmp(progName, name, progLen)) {
+					program = p;
+					break;
+				}
+			}
+			if (program < 0) {
+				fprintf(stderr, "skipping '%s': no matching program\n", name);
+				continue;
+			}
+
+			uint8_t mode = 0;
+			for (const auto& v : out) {
+				if (v.program == program) mode++;
+			}
+			out.push_back({ name, (uint8_t)program, (uint8_t)(MODE_COUNTS[program] ? mode : 0) });
+		}
+		return out;
+	}
+
+	// Fresh init of one visualizer with parameters restored and every random
+	// source reseeded, so a given frame index always renders the same pixels
+	void beginVisualizer(const VisualizerRef& v) {
+		PROGRAM = v.program;
+		MODE = v.mode;
+		restoreParameters(baseParams);
+		resetProgramInstances();
+		randomSeed(1);
+		random16_set_seed(1337);
+		rewindWav();
+		fill_solid(leds, NUM_LEDS, CRGB::Black);
+		outputStage::activeMap = progTopDown;
+	}
+
+	// Canvas permuted to LED (wire) order by the frame's output map, RGB, without
+	// the brightness/correction/gamma LUTs, so dumps stay comparable across builds
+	void frameBytes(uint8_t* out) {
+		const uint16_t* map = outputStage::activeMap;
+		for (uint16_t i = 0; i < NUM_LEDS; i++) {
+			uint8_t* px = out + map[i] * 3;
+			px[0] = leds[i].r;
+			px[1] = leds[i].g;
+			px[2] = leds[i].b;
+		}
+	}
+
+} // namespace hostRunner
@@ -0,0 +1,100 @@
+#pragma once
+
+//========================================================================================
+// Host FFT check: fl::audio::fft vs the Q15 radix-4 backend (hostRunner --fft-check)
+//
+// Pushes a synthetic signal through the FFT ring in 512-sample hops and runs both
+// backends on the same windowed buffer. The signal is a mix of sines, a kick-like
+// decaying burst and noise, with its level swept over 40 dB. For each window length
+// (512/1024/2048) and bin layout (16 and 32 bands) it reports µs per transform for
+// each backend, and the Q15 error against the float result on the 0..1 fft_pre scale
+// the pipeline uses (max and mean abs, plus the mean Q15/float ratio of raw band
+// magnitudes).
+//
+// --frames N sets the number of hops (default 200).
+//========================================================================================
+
+namespace hostRunner {
+
+	int runFftCheck(const Options& opt) {
+
+		const uint32_t hops = opt.framesSet ? opt.frames : 200;
+		const uint32_t sampleRate = myAudio::fftSampleRate();
+		constexpr uint16_t HOP = 512;
+
+		printf("window,bands,backend,us_per_fft,speedup,max_err,mean_err,raw_ratio\n");
+
+		const uint16_t savedWindow = myAudio::fftWindowSamples;
+		const uint16_t windows[3] = { 512, 1024, 2048 };
+		myAudio::binConfig* layouts[2] = { &myAudio::bin16, &myAudio::bin32 };
+		for (uint8_t cfg = 0; cfg < 6; cfg++) {
+
+			const uint16_t window = windows[cfg / 2];
+			myAudio::binConfig* b = layouts[cfg % 2];
+			myAudio::fftWindowSamples = window;
+			myAudio::fftRingValid = 0;
+
+			const uint8_t n = b->NUM_FFT_BINS;
+			uint32_t seed = 12345;
+			int16_t block[HOP];
+			double floatUs = 0.0, fixedUs = 0.0;
+			double maxErr = 0.0, sumErr = 0.0, sumRatio = 0.0;
+			uint32_t compared = 0, ratioCount = 0;
+
+			for (uint32_t h = 0; h < hops; h++) {
+				const float level = powf(10.0f, -2.0f * (float)(h % 50) / 49.0f);   // 0 .. -40 dB
+				for (uint16_t i = 0; i < HOP; i++) {
+					const float t = (float)(h * HOP + i) / sampleRate;
+					const float kickT = fmodf(t, 0.5f);
+					seed = seed * 1664525u + 1013904223u;
+					const float noise = ((int32_t)(seed >> 16) - 32768) / 32768.0f;
+					float v = 0.30f * sinf(6.2831853f * 110.0f * t)
+						+ 0.20f * sinf(6.2831853f * 1250.0f * t)
+						+ 0.10f * sinf(6.2831853f * 5300.0f * t)
+						+ 0.35f * expf(-kickT * 30.0f) * sinf(6.2831853f * 55.0f * kickT)
+						+ 0.05f * noise;
+					block[i] = (int16_t)fl::clamp(v * level * 32767.0f, -32768.0f, 32767.0f);
+				}
+				myAudio::pushFftSamples(block, HOP);
+				if (myAudio::fftRingValid < window) continue;
+				myAudio::unwrapFftWindow();
+
+				auto t0 = std::chrono::steady_clock::now();
+				const myAudio::FftBands* fb = myAudio::runFloatFft(*b);
+				auto t1 = std::chrono::steady_clock::now();
+				floatUs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+				float ref[myAudio::MAX_FFT_BINS];
+				for (uint8_t i = 0; i < n; i++) ref[i] = i < fb->count ? fb->raw[i] : 0.0f;
+
+				t0 = std::chrono::steady_clock::now();
+				const myAudio::FftBands* qb = myAudio::runFixedFft(*b);
+				t1 = std::chrono::steady_clock::now();
+				fixedUs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+
+				for (uint8_t i = 0; i < n; i++) {
+					const double a = fl::clamp(ref[i] / 32768.0f, 0.0f, 1.0f);
+					const double q = fl::clamp(qb->raw[i] / 32768.0f, 0.0f, 1.0f);
+					const double e = fabs(q - a);
+					if (e > maxErr) maxErr = e;
+					sumErr += e;
+					compared++;
+					if (ref[i] > 1.0f) { sumRatio += qb->raw[i] / ref[i]; ratioCount++; }
+				}
+			}
+
+			const uint32_t runs = compared / (n ? n : 1);
+			if (runs == 0) {
+				fprintf(stderr, "--fft-check needs more than %u hops\n", (unsigned)(window / HOP));
+				myAudio::fftWindowSamples = savedWindow;
+				return 2;
+			}
+			printf("%u,%u,float,%.2f,1.00,0,0,1\n", window, n, floatUs / runs);
+			printf("%u,%u,q15,%.2f,%.2f,%.5f,%.5f,%.3f\n", window, n, fixedUs / runs, floatUs / fixedUs,
+				maxErr, sumErr / compared, ratioCount ? sumRatio / ratioCount : 0.0);
+		}
+		myAudio::fftWindowSamples = savedWindow;
+		printf("# hops=%u sample_rate=%u\n", (unsigned)hops, (unsigned)sampleRate);
+		return 0;
+	}
+
+} // namespace hostRunner
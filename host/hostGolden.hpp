@@ -0,0 +1,221 @@
+#pragma once
+
+//========================================================================================
+// Host golden frames: render-output regression checks (hostRunner --golden-record/-check)
+//
+// Every visualizer renders from a fresh, reseeded init on the virtual clock (which is
+// what ANIMartRIX::setTime(), fl::millis() and the EVERY_N_* timers all read), and every
+// --golden-every'th frame is kept as a checkpoint: frame index, clock, CRC32 and the
+// RGB24 frame itself. Baselines live in DIR/<HxW>/<visualizer>.agf.
+//
+// --golden-check passes a checkpoint on an exact CRC match; otherwise, when --psnr-min
+// is set, it passes if PSNR against the stored frame is at least that many dB. Use
+// exact mode for refactors and a PSNR floor (~40 dB) for accuracy-trading kernels
+// such as fast-math, sin_fast/fastpow or fixed-point noise.
+//
+// Baselines are per toolchain: record on the host you check on.
+//========================================================================================
+
+#include <filesystem>
+
+namespace hostRunner {
+
+	static const char GOLDEN_MAGIC[4] = { 'A', 'G', 'L', 'D' };
+	static const uint8_t GOLDEN_VERSION = 1;
+
+	struct __attribute__((packed)) GoldenHeader {
+		char magic[4];
+		uint8_t version;
+		uint8_t reserved;
+		uint16_t height;
+		uint16_t width;
+		uint16_t checkpoints;
+		uint32_t every;
+		float fps;
+		uint32_t startMs;
+	};
+
+	struct __attribute__((packed)) GoldenCheckpoint {
+		uint32_t frame;
+		uint32_t timeMs;
+		uint32_t crc;
+	};
+
+	//=====================================================================
+
+	uint32_t crc32(const uint8_t* data, size_t len) {
+		static uint32_t table[256];
+		static bool tableReady = false;
+		if (!tableReady) {
+			for (uint32_t i = 0; i < 256; i++) {
+				uint32_t c = i;
+				for (uint8_t k = 0; k < 8; k++) c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+				table[i] = c;
+			}
+			tableReady = true;
+		}
+		uint32_t crc = 0xFFFFFFFFu;
+		for (size_t i = 0; i < len; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+		return crc ^ 0xFFFFFFFFu;
+	}
+
+	// PSNR in dB over all channels; returns INFINITY for identical frames
+	float framePsnr(const uint8_t* a, const uint8_t* b, size_t len, uint8_t* maxDeltaOut) {
+		uint64_t sumSq = 0;
+		uint8_t maxDelta = 0;
+		for (size_t i = 0; i < len; i++) {
+			const int d = (int)a[i] - (int)b[i];
+			sumSq += (uint64_t)(d * d);
+			const uint8_t ad = (uint8_t)(d < 0 ? -d : d);
+			if (ad > maxDelta) maxDelta = ad;
+		}
+		if (maxDeltaOut) *maxDeltaOut = maxDelta;
+		if (sumSq == 0) return INFINITY;
+		const double mse = (double)sumSq / len;
+		return (float)(10.0 * log10((255.0 * 255.0) / mse));
+	}
+
+	std::string goldenPath(const char* dir, const VisualizerRef& v) {
+		char geometry[16];
+		snprintf(geometry, sizeof(geometry), "%dx%d", HEIGHT, WIDTH);
+		return std::string(dir) + "/" + geometry + "/" + v.name + ".agf";
+	}
+
+	//=====================================================================
+
+	bool recordGolden(const Options& opt, const VisualizerRef& v) {
+
+		const std::string path = goldenPath(opt.goldenRecordDir, v);
+		std::error_code ec;
+		std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+
+		FILE* out = fopen(path.c_str(), "wb");
+		if (!out) {
+			fprintf(stderr, "cannot write %s\n", path.c_str());
+			return false;
+		}
+
+		GoldenHeader h = {};
+		memcpy(h.magic, GOLDEN_MAGIC, sizeof(h.magic));
+		h.version = GOLDEN_VERSION;
+		h.height = HEIGHT;
+		h.width = WIDTH;
+		h.checkpoints = (uint16_t)((opt.frames + opt.goldenEvery - 1) / opt.goldenEvery);
+		h.every = opt.goldenEvery;
+		h.fps = opt.fps;
+		h.startMs = opt.startMs;
+		fwrite(&h, sizeof(h), 1, out);
+
+		static uint8_t cur[NUM_LEDS * 3];
+
+		beginVisualizer(v);
+		for (uint32_t f = 0; f < opt.frames; f++) {
+			setFrameClock(opt, f);
+			runProgram();
+			if (f % opt.goldenEvery != 0) continue;
+
+			frameBytes(cur);
+			GoldenCheckpoint cp = { f, clockMs, crc32(cur, sizeof(cur)) };
+			fwrite(&cp, sizeof(cp), 1, out);
+			fwrite(cur, 1, sizeof(cur), out);
+		}
+
+		fclose(out);
+		printf("%dx%d,%s,recorded,%u\n", HEIGHT, WIDTH, v.name, (unsigned)h.checkpoints);
+		return true;
+	}
+
+	//=====================================================================
+
+	bool checkGolden(const Options& opt, const VisualizerRef& v) {
+
+		const std::string path = goldenPath(opt.goldenCheckDir, v);
+		FILE* in = fopen(path.c_str(), "rb");
+		if (!in) {
+			printf("%dx%d,%s,missing,0,0,0,0\n", HEIGHT, WIDTH, v.name);
+			return false;
+		}
+
+		GoldenHeader h;
+		if (fread(&h, sizeof(h), 1, in) != 1 || memcmp(h.magic, GOLDEN_MAGIC, sizeof(h.magic)) != 0 ||
+			h.version != GOLDEN_VERSION || h.height != HEIGHT || h.width != WIDTH) {
+			fclose(in);
+			printf("%dx%d,%s,bad-baseline,0,0,0,0\n", HEIGHT, WIDTH, v.name);
+			return false;
+		}
+
+		// Replay with the recorded timing so checkpoints land on the same clock values
+		Options replay = opt;
+		replay.fps = h.fps;
+		replay.startMs = h.startMs;
+
+		static uint8_t cur[NUM_LEDS * 3];
+		static uint8_t ref[NUM_LEDS * 3];
+
+		uint16_t read = 0;
+		uint16_t exact = 0;
+		uint16_t failed = 0;
+		float worstPsnr = INFINITY;
+		uint8_t worstDelta = 0;
+
+		GoldenCheckpoint cp;
+		bool havePending = fread(&cp, sizeof(cp), 1, in) == 1 && fread(ref, 1, sizeof(ref), in) == sizeof(ref);
+
+		beginVisualizer(v);
+		for (uint32_t f = 0; havePending; f++) {
+			setFrameClock(replay, f);
+			runProgram();
+			if (f != cp.frame) continue;
+
+			frameBytes(cur);
+			read++;
+			if (crc32(cur, sizeof(cur)) == cp.crc) {
+				exact++;
+			} else {
+				uint8_t maxDelta = 0;
+				const float psnr = framePsnr(cur, ref, sizeof(cur), &maxDelta);
+				if (psnr < worstPsnr) worstPsnr = psnr;
+				if (maxDelta > worstDelta) worstDelta = maxDelta;
+				if (opt.psnrMin <= 0.0f || psnr < opt.psnrMin) {
+					failed++;
+					fprintf(stderr, "%s: frame %u t=%u psnr=%.2f maxDelta=%u\n",
+						v.name, (unsigned)cp.frame, (unsigned)cp.timeMs, psnr, maxDelta);
+				}
+			}
+			havePending = fread(&cp, sizeof(cp), 1, in) == 1 && fread(ref, 1, sizeof(ref), in) == sizeof(ref);
+		}
+		fclose(in);
+
+		const bool ok = (failed == 0 && read == h.checkpoints);
+		printf("%dx%d,%s,%s,%u,%u,%.2f,%u\n", HEIGHT, WIDTH, v.name, ok ? "pass" : "FAIL",
+			(unsigned)read, (unsigned)exact, worstPsnr, worstDelta);
+		return ok;
+	}
+
+	//=====================================================================
+
+	int runGolden(const Options& opt) {
+
+		const bool recording = (opt.goldenRecordDir != nullptr);
+		uint32_t failures = 0;
+
+		if (recording) {
+			printf("geometry,visualizer,status,checkpoints\n");
+		} else {
+			printf("geometry,visualizer,status,checkpoints,exact,worst_psnr,worst_delta\n");
+		}
+
+		for (const auto& v : listVisualizers()) {
+			if (opt.only && !strstr(v.name, opt.only)) continue;
+			const bool ok = recording ? recordGolden(opt, v) : checkGolden(opt, v);
+			if (!ok) failures++;
+			fflush(stdout);
+		}
+
+		if (!recording) {
+			printf("# golden failures=%u psnr_min=%.1f\n", (unsigned)failures, opt.psnrMin);
+		}
+		return failures ? (recording ? 2 : 1) : 0;
+	}
+
+} // namespace hostRunner
@@ -0,0 +1,83 @@
+#pragma once
+
+//========================================================================================
+// Host noise benchmark: float pnoise() vs the Q16.16 integer kernel (hostRunner --noise-bench)
+//
+// Evaluates both backends over the same coordinate sweep. The sweep is a polar field
+// with drifting offsets, the way render_value() samples it. For each backend it reports
+// ns per call, and for Q16 also its error against the float result (max/RMS on the
+// -1..+1 scale, and the max 0-255 delta after the render_value() map).
+// inoise_q16 is timed twice: once with float->Q16 conversion (what render_value pays),
+// and once on pre-converted coordinates (the kernel alone).
+//
+// Whole-frame impact: --bench --only animartrix, with and without --set cx24=1.
+//========================================================================================
+
+namespace hostRunner {
+
+	int runNoiseBench(const Options& opt) {
+
+		animartrix_detail::build_fade_lut();
+		static animartrix_detail::ANIMartRIX fx;
+
+		// frames x NUM_LEDS samples, so the sweep scales like a render
+		const uint32_t count = opt.frames * NUM_LEDS;
+		std::vector<float> xs(count), ys(count), zs(count);
+		std::vector<int32_t> qx(count), qy(count), qz(count);
+		for (uint32_t i = 0; i < count; i++) {
+			const uint32_t pixel = i % NUM_LEDS;
+			const uint32_t frame = i / NUM_LEDS;
+			const float angle = (pixel % WIDTH) * 0.19f + frame * 0.013f;
+			const float dist = (pixel / WIDTH) * 0.7f;
+			xs[i] = (499.f + 3.f * frame * 0.01f - cosf(angle) * dist) * 0.1f;
+			ys[i] = (499.f - 5.f * frame * 0.01f - sinf(angle) * dist) * 0.1f;
+			zs[i] = (0.5f + frame * 0.2f) * 0.1f;
+			qx[i] = fx.to_q16(xs[i]);
+			qy[i] = fx.to_q16(ys[i]);
+			qz[i] = fx.to_q16(zs[i]);
+		}
+
+		std::vector<float> ref(count), got(count);
+		volatile int64_t sink = 0;
+
+		auto timeNs = [&](auto&& body) {
+			const auto t0 = std::chrono::steady_clock::now();
+			body();
+			const auto t1 = std::chrono::steady_clock::now();
+			return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count() / count;
+		};
+
+		const double floatNs = timeNs([&] {
+			for (uint32_t i = 0; i < count; i++) ref[i] = fx.pnoise(xs[i], ys[i], zs[i]);
+		});
+		const double q16Ns = timeNs([&] {
+			for (uint32_t i = 0; i < count; i++) got[i] = fx.pnoise_q16(xs[i], ys[i], zs[i]);
+		});
+		const double kernelNs = timeNs([&] {
+			int64_t acc = 0;
+			for (uint32_t i = 0; i < count; i++) acc += fx.inoise_q16(qx[i], qy[i], qz[i]);
+			sink = acc;
+		});
+
+		double maxErr = 0.0, sumSq = 0.0;
+		uint8_t maxDelta8 = 0;
+		for (uint32_t i = 0; i < count; i++) {
+			const double e = fabs((double)got[i] - ref[i]);
+			if (e > maxErr) maxErr = e;
+			sumSq += e * e;
+			const int a = (int)fx.map_float(FL_MAX(ref[i], 0.0f), 0.0f, 1.0f, 0, 255);
+			const int b = (int)fx.map_float(FL_MAX(got[i], 0.0f), 0.0f, 1.0f, 0, 255);
+			const uint8_t d = (uint8_t)(a > b ? a - b : b - a);
+			if (d > maxDelta8) maxDelta8 = d;
+		}
+		(void)sink;
+
+		printf("backend,ns_per_call,speedup,max_err,rms_err,max_delta_255\n");
+		printf("float,%.2f,1.00,0,0,0\n", floatNs);
+		printf("q16,%.2f,%.2f,%.5f,%.5f,%u\n", q16Ns, floatNs / q16Ns, maxErr, sqrt(sumSq / count), maxDelta8);
+		printf("q16_kernel,%.2f,%.2f,,,\n", kernelNs, floatNs / kernelNs);
+		printf("# samples=%u\n", (unsigned)count);
+		return 0;
+	}
+
+} // namespace hostRunner
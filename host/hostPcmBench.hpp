@@ -0,0 +1,95 @@
+#pragma once
+
+//========================================================================================
+// Host PCM benchmark: two/three-pass block conditioning vs conditionPcm() (hostRunner --pcm-bench)
+//
+// The reference is the previous filterSample() body. It runs a DC-mean pass, then a
+// spike-mask/DC/RMS copy pass, plus a zeroing pass when the gate is closed. Both
+// versions run over the same synthetic 512-sample blocks: a 220 Hz tone that
+// alternates loud and quiet, a DC offset, noise and occasional I2S-style spikes.
+// It reports ns per block for each version, and conditionPcm()'s block-RMS error
+// against the reference (the value the noise gate sees).
+//
+// --frames N sets the number of blocks (default 4000, ~46 s of audio).
+//========================================================================================
+
+namespace hostRunner {
+
+	// Previous filterSample() conditioning, kept here as the reference
+	float conditionPcmReference(const int16_t* raw, int16_t* out, size_t n, bool gateClosed) {
+		int64_t dcSum = 0;
+		int64_t dcCount = 0;
+		for (size_t i = 0; i < n; i++) {
+			if (raw[i] > -myAudio::SPIKE_THRESHOLD && raw[i] < myAudio::SPIKE_THRESHOLD) {
+				dcSum += raw[i];
+				dcCount++;
+			}
+		}
+		const int16_t dcOffset = (dcCount > 0) ? static_cast<int16_t>(dcSum / dcCount) : 0;
+
+		uint64_t sumSq = 0;
+		size_t validSamples = 0;
+		for (size_t i = 0; i < n; i++) {
+			if (raw[i] > -myAudio::SPIKE_THRESHOLD && raw[i] < myAudio::SPIKE_THRESHOLD) {
+				const int16_t corrected = raw[i] - dcOffset;
+				out[i] = corrected;
+				sumSq += static_cast<int32_t>(corrected) * corrected;
+				validSamples++;
+			} else {
+				out[i] = 0;
+			}
+		}
+		if (gateClosed) {
+			for (size_t i = 0; i < n; i++) out[i] = 0;
+		}
+		return (validSamples > 0) ? sqrtf(static_cast<float>(sumSq) / validSamples) : 0.0f;
+	}
+
+	int runPcmBench(const Options& opt) {
+
+		constexpr uint16_t BLOCK = 512;
+		const uint32_t count = opt.framesSet ? opt.frames : 4000;
+		std::vector<int16_t> pcm((size_t)count * BLOCK);
+		uint32_t seed = 7;
+		for (size_t i = 0; i < pcm.size(); i++) {
+			seed = seed * 1664525u + 1013904223u;
+			const float t = (float)i / 44100.0f;
+			const float amp = ((i / BLOCK) % 40 < 20) ? 4000.0f : 30.0f;
+			const float noise = 200.0f * (((int32_t)(seed >> 16) - 32768) / 32768.0f);
+			float v = 300.0f + amp * sinf(6.2831853f * 220.0f * t) + noise;
+			if ((seed >> 8) % 700 == 0) v = 32000.0f;
+			pcm[i] = (int16_t)fl::clamp(v, -32768.0f, 32767.0f);
+		}
+
+		static int16_t out[BLOCK];
+		myAudio::PcmConditioner st;
+		double maxRel = 0.0;
+		for (uint32_t b = 0; b < count; b++) {
+			const int16_t* in = &pcm[(size_t)b * BLOCK];
+			const float ref = conditionPcmReference(in, out, BLOCK, false);
+			const float got = myAudio::conditionPcm(in, out, BLOCK, st).rms;
+			if (ref > 1.0f) maxRel = FL_MAX(maxRel, fabs((double)got - ref) / ref);
+		}
+
+		volatile float sink = 0.0f;
+		auto timeNs = [&](auto&& body) {
+			const auto t0 = std::chrono::steady_clock::now();
+			for (uint32_t b = 0; b < count; b++) sink = sink + body(&pcm[(size_t)b * BLOCK]);
+			const auto t1 = std::chrono::steady_clock::now();
+			return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count() / count;
+		};
+
+		const double openNs = timeNs([&](const int16_t* in) { return conditionPcmReference(in, out, BLOCK, false); });
+		const double closedNs = timeNs([&](const int16_t* in) { return conditionPcmReference(in, out, BLOCK, true); });
+		const double fusedNs = timeNs([&](const int16_t* in) { return myAudio::conditionPcm(in, out, BLOCK, st).rms; });
+		(void)sink;
+
+		printf("kernel,ns_per_block,speedup,max_rms_rel_err\n");
+		printf("reference_gate_open,%.1f,1.00,0\n", openNs);
+		printf("reference_gate_closed,%.1f,%.2f,0\n", closedNs, openNs / closedNs);
+		printf("conditionPcm,%.1f,%.2f,%.2e\n", fusedNs, openNs / fusedNs, maxRel);
+		printf("# blocks=%u block_samples=%u\n", (unsigned)count, BLOCK);
+		return 0;
+	}
+
+} // namespace hostRunner
@@ -0,0 +1,168 @@
+#pragma once
+
+//========================================================================================
+// Host runner: headless render target for the native build (platformio_native.ini)
+//
+// Included at the bottom of main.cpp when AURORA_HOST is defined, so it drives the
+// same runProgram() dispatch, programs, parameters and leds[] buffer as loop() —
+// just with a virtual clock instead of real time, and no BLE, I2S or LED driver.
+//
+//   pio run -c platformio_native.ini
+//   .pio/build_native/native/program --program 6 --mode 10 --frames 300 --time
+//
+//   --program N        PROGRAM to run (default 6)
+//   --mode N           MODE to run (default 0)
+//   --frames N         number of frames to render (default 60)
+//   --fps F            virtual frame rate; clock advances 1000/F ms per frame (default 60)
+//   --start-ms N       virtual clock value for frame 0 (default 0)
+//   --set id=value     apply a UI parameter before rendering (e.g. inZoom=1.2, cxLayer2=0);
+//                      may be repeated
+//   --dump file.rgb    append every frame as raw RGB24 in LED (wire) order
+//   --diff file.rgb    compare every frame against a previous --dump
+//   --tolerance N      max per-channel delta allowed by --diff (default 0)
+//   --time             report per-frame render time (wall clock, µs)
+//   --verbose          let Serial/debug output through (stderr)
+//
+//   --bench            benchmark every VISUALIZER_PARAM_LOOKUP entry (see hostBench.hpp)
+//   --warmup N         frames rendered before measuring each visualizer (default 10)
+//   --format csv|json  benchmark output format (default csv)
+//   --only text        only benchmark/check visualizers whose name contains text
+//   --noise-bench      time float pnoise() against the Q16.16 integer kernel over
+//                      --frames x NUM_LEDS samples (see hostNoiseBench.hpp)
+//   --fft-check        compare the Q15 FFT backend (cx25) against fl::audio::fft for
+//                      accuracy and µs per transform (see hostFftCheck.hpp)
+//   --pcm-bench        time the fused conditionPcm() kernel against the previous multi-pass
+//                      block conditioning (see hostPcmBench.hpp)
+//
+//   --golden-record D  record checkpoint frames of every visualizer under D (see hostGolden.hpp)
+//   --golden-check D   re-render and compare against the baselines under D
+//   --golden-every N   keep every Nth frame as a checkpoint (default 10)
+//   --psnr-min dB      accept non-identical checkpoints at or above this PSNR (default: exact)
+//
+//   --wav file.wav     feed a WAV file through the audio pipeline in place of the I2S mic,
+//                      in 512-sample blocks paced by the virtual clock (see hostAudioReplay.hpp)
+//   --audio-csv F      audio-only replay: one AudioFrame row per frame into F, plus per-block
+//                      processing cost; runs until the file ends unless --frames is given
+//   --fft-hop N        samples between spectra (default 512 = one per DMA block); use with
+//                      --audio-csv to compare beat timing at e.g. 256 vs 512
+//
+// Exit status: 0 ok, 1 --diff / --golden-check mismatch, 2 bad arguments / io error.
+//========================================================================================
+
+#include "hostCore.hpp"
+#include "hostBench.hpp"
+#include "hostGolden.hpp"
+#include "hostAudioReplay.hpp"
+#include "hostNoiseBench.hpp"
+#include "hostFftCheck.hpp"
+#include "hostPcmBench.hpp"
+
+namespace hostRunner {
+
+	//=====================================================================
+
+	// Renders one PROGRAM/MODE; optional per-frame timing, dump and diff
+	int runSingle(const Options& opt) {
+
+		FILE* dumpFile = nullptr;
+		FILE* diffFile = nullptr;
+		if (opt.dumpPath && !(dumpFile = fopen(opt.dumpPath, "wb"))) {
+			fprintf(stderr, "cannot open %s\n", opt.dumpPath);
+			return 2;
+		}
+		if (opt.diffPath && !(diffFile = fopen(opt.diffPath, "rb"))) {
+			fprintf(stderr, "cannot open %s\n", opt.diffPath);
+			if (dumpFile) fclose(dumpFile);
+			return 2;
+		}
+
+		static uint8_t cur[NUM_LEDS * 3];
+		static uint8_t ref[NUM_LEDS * 3];
+
+		uint64_t totalUs = 0;
+		uint32_t maxUs = 0;
+		uint32_t mismatchedFrames = 0;
+		int status = 0;
+
+		printf("# %s %dx%d frames=%u fps=%.1f\n",
+			VisualizerManager::getVisualizerName(opt.program, opt.mode).c_str(),
+			HEIGHT, WIDTH, (unsigned)opt.frames, opt.fps);
+
+		for (uint32_t f = 0; f < opt.frames; f++) {
+
+			setFrameClock(opt, f);
+			const uint32_t us = renderFrame();
+			totalUs += us;
+			if (us > maxUs) maxUs = us;
+
+			frameBytes(cur);
+
+			if (dumpFile) {
+				fwrite(cur, 1, sizeof(cur), dumpFile);
+			}
+
+			if (diffFile) {
+				if (fread(ref, 1, sizeof(ref), diffFile) != sizeof(ref)) {
+					fprintf(stderr, "reference ends before frame %u\n", (unsigned)f);
+					status = 1;
+					break;
+				}
+				uint8_t maxDelta = 0;
+				uint32_t diffChannels = 0;
+				for (size_t i = 0; i < sizeof(cur); i++) {
+					const uint8_t d = cur[i] > ref[i] ? cur[i] - ref[i] : ref[i] - cur[i];
+					if (d) diffChannels++;
+					if (d > maxDelta) maxDelta = d;
+				}
+				if (maxDelta > opt.tolerance) {
+					mismatchedFrames++;
+					printf("diff frame=%u t=%u maxDelta=%u channels=%u\n",
+						(unsigned)f, (unsigned)clockMs, maxDelta, (unsigned)diffChannels);
+				}
+			}
+
+			if (opt.timing) {
+				printf("frame=%u t=%u us=%u\n", (unsigned)f, (unsigned)clockMs, (unsigned)us);
+			}
+		}
+
+		if (dumpFile) fclose(dumpFile);
+		if (diffFile) fclose(diffFile);
+
+		if (opt.timing && opt.frames > 0) {
+			printf("# mean_us=%.1f max_us=%u\n", (double)totalUs / opt.frames, (unsigned)maxUs);
+		}
+		if (opt.diffPath) {
+			printf("# diff mismatched_frames=%u tolerance=%u\n", (unsigned)mismatchedFrames, opt.tolerance);
+			if (mismatchedFrames > 0) status = 1;
+		}
+
+		return status;
+	}
+
+	//=====================================================================
+
+	int run(int argc, char** argv) {
+
+		Options opt;
+		if (!parseArgs(argc, argv, opt)) {
+			printUsage();
+			return 2;
+		}
+
+		hostSetup(opt);
+		if (opt.wavPath && !attachWav(opt)) return 2;
+
+		if (opt.audioCsvPath) return runAudioReplay(opt);
+		if (opt.noiseBench) return runNoiseBench(opt);
+		if (opt.fftCheck) return runFftCheck(opt);
+		if (opt.pcmBench) return runPcmBench(opt);
+		if (opt.goldenRecordDir || opt.goldenCheckDir) return runGolden(opt);
+		return opt.bench ? runBench(opt) : runSingle(opt);
+	}
+
+} // namespace hostRunner
+
+int main(int argc, char** argv) {
+	return hostRunner::run(argc, argv);
+}
@@ -0,0 +1,229 @@
+#pragma once
+
+// ═══════════════════════════════════════════════════════════════════
+//  Host (native) Arduino shim
+//  Just enough of the Arduino core for main.cpp, bleControl.h and the
+//  programs to compile against FastLED's stub platform on Linux.
+//  millis()/micros()/delay() come from FastLED's stub time layer, which
+//  the host runner drives with its own virtual clock.
+// ═══════════════════════════════════════════════════════════════════
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+
+#ifndef AURORA_HOST
+    #define AURORA_HOST 1
+#endif
+
+typedef uint8_t byte;
+
+#ifndef PROGMEM
+    #define PROGMEM
+#endif
+#ifndef pgm_read_byte
+    #define pgm_read_byte(addr)  (*(const uint8_t*)(addr))
+#endif
+#ifndef pgm_read_word
+    #define pgm_read_word(addr)  (*(const uint16_t*)(addr))
+#endif
+#ifndef pgm_read_dword
+    #define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#endif
+#ifndef pgm_read_float
+    #define pgm_read_float(addr) (*(const float*)(addr))
+#endif
+#ifndef pgm_read_ptr
+    #define pgm_read_ptr(addr)   (*(void* const*)(addr))
+#endif
+
+#ifndef PI
+    #define PI 3.1415926535897932384626433832795
+#endif
+
+#ifndef constrain
+    #define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#endif
+
+// Provided by FastLED's stub platform (platforms/stub/time_stub.cpp)
+extern "C" {
+    uint32_t millis(void);
+    uint32_t micros(void);
+    void delay(int ms);
+    void yield(void);
+}
+
+//=====================================================================
+// Deterministic random()/map() — frames must be reproducible run-to-run
+
+namespace aurora_host {
+    inline uint32_t& randomState() { static uint32_t s = 0x2545F491u; return s; }
+    inline uint32_t nextRandom() {
+        uint32_t& s = randomState();
+        s ^= s << 13; s ^= s >> 17; s ^= s << 5;
+        return s;
+    }
+}
+
+inline void randomSeed(unsigned long seed) { aurora_host::randomState() = seed ? (uint32_t)seed : 0x2545F491u; }
+
+inline long random(long howbig) {
+    if (howbig <= 0) return 0;
+    return (long)(aurora_host::nextRandom() % (uint32_t)howbig);
+}
+
+inline long random(long howsmall, long howbig) {
+    if (howsmall >= howbig) return howsmall;
+    return howsmall + random(howbig - howsmall);
+}
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    if (in_max == in_min) return out_min;
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+//=====================================================================
+// String
+
+class String {
+public:
+    String() {}
+    String(const char* s) { if (s) str_ = s; }
+    String(const std::string& s) : str_(s) {}
+    String(char c) : str_(1, c) {}
+    String(unsigned char v) : str_(std::to_string((unsigned)v)) {}
+    String(int v) : str_(std::to_string(v)) {}
+    String(unsigned int v) : str_(std::to_string(v)) {}
+    String(long v) : str_(std::to_string(v)) {}
+    String(unsigned long v) : str_(std::to_string(v)) {}
+    String(float v, unsigned char decimals = 2) { fromFloat(v, decimals); }
+    String(double v, unsigned char decimals = 2) { fromFloat(v, decimals); }
+
+    const char* c_str() const { return str_.c_str(); }
+    unsigned int length() const { return (unsigned int)str_.length(); }
+    bool reserve(unsigned int size) { str_.reserve(size); return true; }
+
+    bool concat(const String& s) { str_ += s.str_; return true; }
+    bool concat(const char* s) { if (s) str_ += s; return true; }
+    bool concat(const char* s, unsigned int len) { if (s) str_.append(s, len); return true; }
+    bool concat(char c) { str_ += c; return true; }
+
+    template <typename T>
+    String& operator+=(const T& v) { concat(String(v)); return *this; }
+
+    char operator[](unsigned int i) const { return i < str_.length() ? str_[i] : 0; }
+
+    bool equals(const String& o) const { return str_ == o.str_; }
+    bool equals(const char* o) const { return o && str_ == o; }
+    bool startsWith(const char* prefix) const { return prefix && str_.compare(0, strlen(prefix), prefix) == 0; }
+
+    bool operator==(const String& o) const { return str_ == o.str_; }
+    bool operator==(const char* o) const { return o && str_ == o; }
+    bool operator!=(const String& o) const { return !(*this == o); }
+    bool operator!=(const char* o) const { return !(*this == o); }
+    bool operator<(const String& o) const { return str_ < o.str_; }
+
+    long toInt() const { return strtol(str_.c_str(), nullptr, 10); }
+    float toFloat() const { return strtof(str_.c_str(), nullptr); }
+
+private:
+    void fromFloat(double v, unsigned char decimals) {
+        char buf[48];
+        snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+        str_ = buf;
+    }
+    std::string str_;
+};
+
+template <typename T>
+inline String operator+(const String& lhs, const T& rhs) { String out(lhs); out += rhs; return out; }
+inline String operator+(const char* lhs, const String& rhs) { String out(lhs); out += rhs; return out; }
+
+//=====================================================================
+// Print / Stream — the shape ArduinoJson expects for serialize/deserialize
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buf, size_t size) {
+        size_t n = 0;
+        while (size--) n += write(*buf++);
+        return n;
+    }
+    size_t write(const char* s) { return s ? write((const uint8_t*)s, strlen(s)) : 0; }
+    virtual void flush() {}
+
+    size_t print(const String& s) { return write((const uint8_t*)s.c_str(), s.length()); }
+    size_t print(const char* s) { return write(s); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char v) { return print(String(v)); }
+    size_t print(int v) { return print(String(v)); }
+    size_t print(unsigned int v) { return print(String(v)); }
+    size_t print(long v) { return print(String(v)); }
+    size_t print(unsigned long v) { return print(String(v)); }
+    size_t print(double v, int decimals = 2) { return print(String(v, (unsigned char)decimals)); }
+
+    size_t println() { return write("\r\n"); }
+    template <typename T>
+    size_t println(const T& v) { size_t n = print(v); return n + println(); }
+    size_t println(double v, int decimals) { size_t n = print(v, decimals); return n + println(); }
+
+    size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        char buf[512];
+        va_list args;
+        va_start(args, fmt);
+        int len = vsnprintf(buf, sizeof(buf), fmt, args);
+        va_end(args);
+        if (len <= 0) return 0;
+        return write((const uint8_t*)buf, std::min((size_t)len, sizeof(buf) - 1));
+    }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    size_t readBytes(char* buffer, size_t length) {
+        size_t n = 0;
+        while (n < length) {
+            int c = read();
+            if (c < 0) break;
+            buffer[n++] = (char)c;
+        }
+        return n;
+    }
+    size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+};
+
+//=====================================================================
+// Serial — goes to stderr so the runner's stdout stays machine-readable
+
+class HostSerial : public Stream {
+public:
+    void begin(unsigned long) {}
+    void setTxTimeoutMs(uint32_t) {}
+    void setMuted(bool muted) { muted_ = muted; }
+    operator bool() const { return true; }
+
+    size_t write(uint8_t c) override { return muted_ ? 1 : fwrite(&c, 1, 1, stderr); }
+    size_t write(const uint8_t* buf, size_t size) override { return muted_ ? size : fwrite(buf, 1, size, stderr); }
+    using Print::write;
+    void flush() override { fflush(stderr); }
+
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+
+private:
+    bool muted_ = false;
+};
+
+inline HostSerial Serial;
@@ -0,0 +1,60 @@
+#pragma once
+
+// Host shim: Arduino FS File over stdio. LittleFS.h maps paths into a
+// directory on the host (./littlefs by default, AURORA_HOST_FS to override).
+
+#include <Arduino.h>
+
+namespace fs {
+
+class File : public Stream {
+public:
+    File() {}
+    explicit File(FILE* f) : f_(f) {}
+    File(File&& o) noexcept : f_(o.f_) { o.f_ = nullptr; }
+    File& operator=(File&& o) noexcept { if (this != &o) { close(); f_ = o.f_; o.f_ = nullptr; } return *this; }
+    File(const File&) = delete;
+    File& operator=(const File&) = delete;
+    ~File() override { close(); }
+
+    explicit operator bool() const { return f_ != nullptr; }
+
+    size_t write(uint8_t c) override { return f_ ? fwrite(&c, 1, 1, f_) : 0; }
+    size_t write(const uint8_t* buf, size_t size) override { return f_ ? fwrite(buf, 1, size, f_) : 0; }
+    using Print::write;
+    void flush() override { if (f_) fflush(f_); }
+
+    int available() override {
+        if (!f_) return 0;
+        long pos = ftell(f_);
+        fseek(f_, 0, SEEK_END);
+        long end = ftell(f_);
+        fseek(f_, pos, SEEK_SET);
+        return (int)(end - pos);
+    }
+    int read() override { return f_ ? fgetc(f_) : -1; }
+    int peek() override {
+        if (!f_) return -1;
+        int c = fgetc(f_);
+        if (c != EOF) ungetc(c, f_);
+        return c;
+    }
+    size_t read(uint8_t* buf, size_t size) { return f_ ? fread(buf, 1, size, f_) : 0; }
+    size_t size() {
+        if (!f_) return 0;
+        long pos = ftell(f_);
+        fseek(f_, 0, SEEK_END);
+        long end = ftell(f_);
+        fseek(f_, pos, SEEK_SET);
+        return (size_t)end;
+    }
+
+    void close() { if (f_) { fclose(f_); f_ = nullptr; } }
+
+private:
+    FILE* f_ = nullptr;
+};
+
+} // namespace fs
+
+using fs::File;
@@ -0,0 +1,46 @@
+#pragma once
+
+// Host shim: LittleFS backed by a plain directory.
+
+#include "FS.h"
+#include <filesystem>
+
+namespace fs {
+
+class HostLittleFS {
+public:
+    bool begin(bool formatOnFail = false) {
+        (void)formatOnFail;
+        std::error_code ec;
+        std::filesystem::create_directories(root(), ec);
+        return !ec;
+    }
+
+    File open(const String& path, const char* mode = "r") { return open(path.c_str(), mode); }
+    File open(const char* path, const char* mode = "r") {
+        const std::string full = root() + (path && path[0] == '/' ? "" : "/") + (path ? path : "");
+        const char* m = (mode && mode[0] == 'w') ? "wb" : (mode && mode[0] == 'a') ? "ab" : "rb";
+        return File(fopen(full.c_str(), m));
+    }
+
+    bool exists(const char* path) { return std::filesystem::exists(root() + path); }
+    bool exists(const String& path) { return exists(path.c_str()); }
+    bool remove(const char* path) { return std::filesystem::remove(root() + path); }
+    bool remove(const String& path) { return remove(path.c_str()); }
+    bool rename(const char* from, const char* to) {
+        std::error_code ec;
+        std::filesystem::rename(root() + from, root() + to, ec);    // replaces `to`, as LittleFS does
+        return !ec;
+    }
+    bool rename(const String& from, const String& to) { return rename(from.c_str(), to.c_str()); }
+
+private:
+    static std::string root() {
+        const char* env = getenv("AURORA_HOST_FS");
+        return env ? env : "littlefs";
+    }
+};
+
+} // namespace fs
+
+inline fs::HostLittleFS LittleFS;
@@ -0,0 +1,115 @@
+#pragma once
+
+// Host shim: no-op NimBLE surface used by bleControl.h. Characteristics keep
+// their last value so the runner can inspect receipts, but nothing is sent.
+
+#include <Arduino.h>
+#include <vector>
+
+class NimBLEServer;
+class NimBLECharacteristic;
+
+class NimBLEUUID {
+public:
+    NimBLEUUID(const char* uuid = "") : uuid_(uuid ? uuid : "") {}
+private:
+    std::string uuid_;
+};
+
+class NimBLEConnInfo {};
+
+class NimBLEAttValue {
+public:
+    NimBLEAttValue() {}
+    NimBLEAttValue(const uint8_t* data, size_t len) : data_(data, data + len) {}
+    size_t size() const { return data_.size(); }
+    size_t length() const { return data_.size(); }
+    const uint8_t* data() const { return data_.data(); }
+    uint8_t operator[](size_t i) const { return i < data_.size() ? data_[i] : 0; }
+    const char* c_str() const {
+        cstr_.assign(data_.begin(), data_.end());
+        return cstr_.c_str();
+    }
+private:
+    std::vector<uint8_t> data_;
+    mutable std::string cstr_;
+};
+
+namespace NIMBLE_PROPERTY {
+    enum : uint16_t { READ = 0x0002, WRITE_NR = 0x0004, WRITE = 0x0008, NOTIFY = 0x0010 };
+}
+
+class NimBLECharacteristicCallbacks {
+public:
+    virtual ~NimBLECharacteristicCallbacks() {}
+    virtual void onWrite(NimBLECharacteristic* pCharacteristic, NimBLEConnInfo& connInfo) { (void)pCharacteristic; (void)connInfo; }
+};
+
+class NimBLEServerCallbacks {
+public:
+    virtual ~NimBLEServerCallbacks() {}
+    virtual void onConnect(NimBLEServer* pServer, NimBLEConnInfo& connInfo) { (void)pServer; (void)connInfo; }
+    virtual void onDisconnect(NimBLEServer* pServer, NimBLEConnInfo& connInfo, int reason) { (void)pServer; (void)connInfo; (void)reason; }
+};
+
+class NimBLECharacteristic {
+public:
+    void setCallbacks(NimBLECharacteristicCallbacks* callbacks) { callbacks_ = callbacks; }
+    NimBLECharacteristicCallbacks* getCallbacks() const { return callbacks_; }
+
+    void setValue(const uint8_t* data, size_t len) { value_ = NimBLEAttValue(data, len); }
+    void setValue(const char* s) { setValue((const uint8_t*)s, s ? strlen(s) : 0); }
+    void setValue(const String& s) { setValue((const uint8_t*)s.c_str(), s.length()); }
+    void setValue(const std::string& s) { setValue((const uint8_t*)s.data(), s.size()); }
+    NimBLEAttValue getValue() const { return value_; }
+
+    bool notify() { notifyCount_++; return true; }
+    uint32_t notifyCount() const { return notifyCount_; }
+
+private:
+    NimBLECharacteristicCallbacks* callbacks_ = nullptr;
+    NimBLEAttValue value_;
+    uint32_t notifyCount_ = 0;
+};
+
+class NimBLEService {
+public:
+    NimBLECharacteristic* createCharacteristic(const char* uuid, uint32_t properties) {
+        (void)uuid; (void)properties;
+        characteristics_.push_back(new NimBLECharacteristic());
+        return characteristics_.back();
+    }
+private:
+    std::vector<NimBLECharacteristic*> characteristics_;
+};
+
+class NimBLEServer {
+public:
+    void setCallbacks(NimBLEServerCallbacks* callbacks) { callbacks_ = callbacks; }
+    NimBLEService* createService(const char* uuid) { (void)uuid; return new NimBLEService(); }
+    bool startAdvertising() { return true; }
+private:
+    NimBLEServerCallbacks* callbacks_ = nullptr;
+};
+
+class NimBLEAdvertisementData {
+public:
+    void setName(const char* name) { (void)name; }
+    void setCompleteServices(const NimBLEUUID& uuid) { (void)uuid; }
+};
+
+class NimBLEAdvertising {
+public:
+    void addServiceUUID(const char* uuid) { (void)uuid; }
+    void setAdvertisementData(const NimBLEAdvertisementData& data) { (void)data; }
+    void setScanResponseData(const NimBLEAdvertisementData& data) { (void)data; }
+    bool start() { return true; }
+};
+
+class NimBLEDevice {
+public:
+    static void init(const char* name) { (void)name; }
+    static void setMTU(uint16_t mtu) { (void)mtu; }
+    static NimBLEServer* createServer() { static NimBLEServer server; return &server; }
+    static NimBLEAdvertising* getAdvertising() { static NimBLEAdvertising adv; return &adv; }
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+// Host shim: in-memory Preferences (NVS). Values live for the process only.
+
+#include <Arduino.h>
+#include <map>
+
+class Preferences {
+public:
+    bool begin(const char* name, bool readOnly = false) {
+        ns_ = name ? name : "";
+        readOnly_ = readOnly;
+        return true;
+    }
+    void end() {}
+
+    uint8_t getUChar(const char* key, uint8_t defaultValue = 0) {
+        auto it = store().find(ns_ + "/" + key);
+        return it == store().end() ? defaultValue : it->second;
+    }
+    size_t putUChar(const char* key, uint8_t value) {
+        if (readOnly_) return 0;
+        store()[ns_ + "/" + key] = value;
+        return 1;
+    }
+
+private:
+    static std::map<std::string, uint8_t>& store() { static std::map<std::string, uint8_t> s; return s; }
+    std::string ns_;
+    bool readOnly_ = false;
+};
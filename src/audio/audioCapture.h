@@ -8,8 +8,10 @@
 
 #include "audioTypes.h"
 #include "audioInput.h"
+#include "fftQ15.h"
+#include "filterbank.h"
 #include "parameterSchema.h"
-#include "fl/stl/cstring.h"  // fl::memcpy, fl::memmove
+#include "fl/stl/cstring.h"  // fl::memcpy
 
 namespace myAudio {
 
@@ -17,6 +19,67 @@ namespace myAudio {
     // sampleAudio — I2S read, spike filter, DC correction, noise gate
     //=====================================================================
 
+    //=========================================================================
+    // conditionPcm — spike mask, DC removal and RMS in one pass
+    //
+    // Samples at or beyond ±SPIKE_THRESHOLD are I2S glitches and become 0.
+    // DC removal is a running high-pass at block rate. Each block is corrected
+    // with the estimate carried in from earlier blocks. The block's spike-free
+    // mean then pulls the estimate by DC_ALPHA (~3 Hz corner at 512 samples,
+    // 44.1 kHz). The RMS is still taken about the block's own mean, as the
+    // two-pass version did: Σ(x-m)² = Σ(x-d)² - n·(m-d)².
+    //
+    // The loop is branch-free over int16 lanes with integer accumulators, so the
+    // compiler can vectorise it where the target has int16 SIMD (SSE2/NEON on the
+    // host build); on Xtensa it is one tight scalar loop instead of three.
+    //=========================================================================
+
+    constexpr int16_t SPIKE_THRESHOLD = 10000;  // I2S occasionally produces spurious samples near int16_t max/min
+    constexpr float DC_ALPHA = 0.25f;
+
+    struct PcmConditioner {
+        float dc = 0.0f;
+        bool dcValid = false;
+    };
+
+    struct PcmBlockStats {
+        float rms = 0.0f;
+        uint16_t valid = 0;
+    };
+
+    PcmConditioner pcmConditioner;
+    static const int16_t silentPcm[sizeof(filteredPcmBuffer) / sizeof(filteredPcmBuffer[0])] = {0};
+
+    inline PcmBlockStats conditionPcm(const int16_t* __restrict in, int16_t* __restrict out,
+                                      size_t n, PcmConditioner& st) {
+        const int32_t d = st.dcValid ? static_cast<int32_t>(lrintf(st.dc)) : 0;
+        int32_t sum = 0;            // |x| < 10000, n <= 512: fits
+        int64_t sumSq = 0;
+        int32_t valid = 0;
+        for (size_t i = 0; i < n; i++) {
+            const int32_t x = in[i];
+            const int32_t keep = (x > -SPIKE_THRESHOLD) & (x < SPIKE_THRESHOLD);
+            const int32_t y = (x - d) * keep;
+            out[i] = static_cast<int16_t>(y);
+            sum += x * keep;
+            sumSq += y * y;
+            valid += keep;
+        }
+
+        PcmBlockStats r;
+        r.valid = static_cast<uint16_t>(valid);
+        if (valid == 0) return r;
+
+        const float mean = static_cast<float>(sum) / valid;
+        const float offset = mean - d;
+        const float variance = static_cast<float>(sumSq) / valid - offset * offset;
+        r.rms = fl::sqrtf(FL_MAX(variance, 0.0f));
+
+        st.dc = st.dcValid ? st.dc + DC_ALPHA * (mean - st.dc) : mean;
+        st.dcValid = true;
+        return r;
+    }
+
     //=========================================================================
     // filterSample — spike filter, DC correction, noise gate (+ optional Processor.update)
     //
@@ -31,9 +94,6 @@ namespace myAudio {
             return;
         }
 
-        // Spike filtering: I2S occasionally produces spurious samples near int16_t max/min
-        constexpr int16_t SPIKE_THRESHOLD = 10000;  // Samples beyond this are glitches
-
         const auto& rawPcm = currentSample.pcm();
         const size_t n = rawPcm.size();
 
@@ -41,36 +101,11 @@ namespace myAudio {
         const size_t kCap = sizeof(filteredPcmBuffer) / sizeof(filteredPcmBuffer[0]);
         const size_t nClamped = (n > kCap) ? kCap : n;
 
-        // Calculate DC offset from non-spike samples
-        int64_t dcSum = 0;
-        size_t dcCount = 0;
-        for (size_t i = 0; i < n; i++) {
-            if (rawPcm[i] > -SPIKE_THRESHOLD && rawPcm[i] < SPIKE_THRESHOLD) {
-                dcSum += rawPcm[i];
-                dcCount++;
-            }
-        }
-        int16_t dcOffset = (dcCount > 0) ? static_cast<int16_t>(dcSum / dcCount) : 0;
-
-        // Copy samples to filtered buffer, replacing spikes with zero.
-        // Also calculate RMS for noise gate decision.
-        uint64_t sumSq = 0;
-        size_t validSamples = 0;
+        const PcmBlockStats stats = conditionPcm(rawPcm.data(), filteredPcmBuffer, nClamped, pcmConditioner);
 
-        for (size_t i = 0; i < nClamped; i++) {
-            if (rawPcm[i] > -SPIKE_THRESHOLD && rawPcm[i] < SPIKE_THRESHOLD) {
-                int16_t corrected = rawPcm[i] - dcOffset;
-                filteredPcmBuffer[i] = corrected;
-                sumSq += static_cast<int32_t>(corrected) * corrected;
-                validSamples++;
-            } else {
-                filteredPcmBuffer[i] = 0;
-            }
-        }
-
-        float blockRMS = (validSamples > 0) ? fl::sqrtf(static_cast<float>(sumSq) / validSamples) : 0.0f;
+        float blockRMS = stats.rms;
         lastBlockRms = blockRMS;
-        lastValidSamples = static_cast<uint16_t>(validSamples);
+        lastValidSamples = stats.valid;
         lastClampedSamples = static_cast<uint16_t>(nClamped);
 
         // EMA-smooth blockRMS before gate decision so brief noise spikes don't open the gate.
@@ -88,14 +123,8 @@ namespace myAudio {
             noiseGateOpen = false;
         }
 
-        // If gate is closed, zero out entire buffer
-        if (!noiseGateOpen) {
-            for (size_t i = 0; i < nClamped; i++) {
-                filteredPcmBuffer[i] = 0;
-            }
-        }
-
-        fl::span<const int16_t> filteredSpan(filteredPcmBuffer, nClamped);
+        // Gate closed: publish silence rather than zeroing the buffer
+        fl::span<const int16_t> filteredSpan(noiseGateOpen ? filteredPcmBuffer : silentPcm, nClamped);
         filteredSample = fl::audio::Sample(filteredSpan, currentSample.timestamp());
 
         if (updateAudioProcessor) {
@@ -326,68 +355,210 @@ namespace myAudio {
     //=====================================================================
     // FFT — Unified FFT path (avoids AudioContext stack usage)
     // Uses static FFT storage and explicit args for consistent bins.
+    //
+    // Filtered PCM goes into a FFT_MAX_WINDOW_SAMPLES ring (one store per sample,
+    // no shifting). Each analysis unwraps the newest fftWindowSamples oldest-first
+    // into fftScratch and applies the window in the same pass, so a spectrum can be
+    // taken after every fftHopSamples without moving the history, and the window
+    // length can change without losing it.
     //=====================================================================
 
     static fl::audio::fft::Bins fftBins(myAudio::MAX_FFT_BINS);
-    static fl::audio::fft::FFT fftEngine;
+    static fl::audio::fft::FFT fftEngine;   // caches its plan per fft::Args (size, bands, range, rate)
+    static FftBands fftBands;               // float path result, copied out of fftBins
+
+    static_assert((FFT_MAX_WINDOW_SAMPLES & (FFT_MAX_WINDOW_SAMPLES - 1)) == 0,
+                  "FFT ring indexing needs a power-of-two length");
+    constexpr uint16_t FFT_RING_MASK = FFT_MAX_WINDOW_SAMPLES - 1;
+
+    static int16_t fftRing[FFT_MAX_WINDOW_SAMPLES] = {0};
+    static uint16_t fftRingHead = 0;      // next write position == oldest sample
+    static size_t fftRingValid = 0;       // how many newest samples are real (startup ramp)
+    static int16_t fftScratch[FFT_MAX_WINDOW_SAMPLES];
+
+    // Hann window in Q14 scaled by 2 (0..32768), so the coherent gain stays 1.0
+    // and bin levels match the unwindowed tuning. |filtered pcm| < 10000 keeps
+    // the doubled peak inside int16. Built for fftWindowSamples on first use
+    // after a size change.
+    static uint16_t fftWindowQ14[FFT_MAX_WINDOW_SAMPLES];
+    static uint16_t fftWindowBuiltFor = 0;
+
+    inline void buildFftWindow() {
+        const uint16_t n = fftWindowSamples;
+        for (uint16_t i = 0; i < n; i++) {
+            const float w = 1.0f - fl::cosf(6.28318531f * i / n);
+            fftWindowQ14[i] = static_cast<uint16_t>(w * 16384.0f + 0.5f);
+        }
+        fftWindowBuiltFor = n;
+    }
 
-    const fl::audio::fft::Bins* getFFT(binConfig& b) {
-        if (!filteredSample.isValid()) return nullptr;
+    inline void pushFftSamples(const int16_t* pcm, size_t n) {
+        // A block longer than the ring only contributes its newest samples
+        if (n > FFT_MAX_WINDOW_SAMPLES) {
+            pcm += n - FFT_MAX_WINDOW_SAMPLES;
+            n = FFT_MAX_WINDOW_SAMPLES;
+        }
+        uint16_t head = fftRingHead;
+        for (size_t i = 0; i < n; i++) {
+            fftRing[head] = pcm[i];
+            head = (head + 1) & FFT_RING_MASK;
+        }
+        fftRingHead = head;
+        fftRingValid += n;
+        if (fftRingValid > FFT_MAX_WINDOW_SAMPLES) fftRingValid = FFT_MAX_WINDOW_SAMPLES;
+    }
 
-        const auto &pcm = filteredSample.pcm();
-        if (pcm.size() == 0) return nullptr;
+    // Hop in samples, clamped to what one DMA block can be cut into
+    inline uint16_t fftHop(size_t blockSamples) {
+        uint16_t hop = fftHopSamples;
+        if (hop < FFT_MIN_HOP_SAMPLES) hop = FFT_MIN_HOP_SAMPLES;
+        if (blockSamples > 0 && hop > blockSamples) hop = static_cast<uint16_t>(blockSamples);
+        return hop;
+    }
 
-        // Build a larger FFT window (typically 1024) from the most recent filtered PCM.
-        // This avoids "empty" LOG_REBIN bins in the low end when using 16 bands and
-        // keeps the bin geometry musically meaningful (e.g., ~60Hz–5kHz coverage).
-        //
-        // Input arrives in 512-sample DMA blocks; we stitch a rolling window.
-        static int16_t fftWindow[FFT_WINDOW_SAMPLES] = {0};
-        static size_t fftWindowValid = 0;  // how many newest samples are real (startup ramp)
-
-        const size_t wantN = static_cast<size_t>(FFT_WINDOW_SAMPLES);
-        if (pcm.size() >= wantN) {
-            // If the input block size ever grows beyond our window, just take the newest wantN.
-            fl::memcpy(fftWindow, pcm.data() + (pcm.size() - wantN), wantN * sizeof(int16_t));
-            fftWindowValid = wantN;
-        } else {
-            // Shift older samples down and append the newest block at the end.
-            const size_t appendN = pcm.size();
-            const size_t keepN = wantN - appendN;
-            fl::memmove(fftWindow, fftWindow + appendN, keepN * sizeof(int16_t));
-            fl::memcpy(fftWindow + keepN, pcm.data(), appendN * sizeof(int16_t));
-            fftWindowValid += appendN;
-            if (fftWindowValid > wantN) fftWindowValid = wantN;
+    // Newest fftWindowSamples of the ring -> fftScratch, oldest first, windowed on the way
+    inline void unwrapFftWindow() {
+        const uint16_t n = fftWindowSamples;
+        if (fftWindowBuiltFor != n) buildFftWindow();
+
+        // Unwrap + window: [start, end of ring) then [0, rest)
+        const uint16_t start = (fftRingHead - n) & FFT_RING_MASK;
+        const uint16_t firstN = FL_MIN(n, (uint16_t)(FFT_MAX_WINDOW_SAMPLES - start));
+        for (uint16_t i = 0; i < firstN; i++) {
+            const int32_t v = (static_cast<int32_t>(fftRing[start + i]) * fftWindowQ14[i]) >> 14;
+            fftScratch[i] = static_cast<int16_t>(fl::clamp(v, (int32_t)-32768, (int32_t)32767));
         }
-
-        // Not enough history yet (startup). We can still run FFT on a partially-zero window,
-        // but returning nullptr makes downstream "valid" checks more predictable.
-        if (fftWindowValid < wantN / 2) {
-            return nullptr;
+        for (uint16_t i = firstN; i < n; i++) {
+            const int32_t v = (static_cast<int32_t>(fftRing[i - firstN]) * fftWindowQ14[i]) >> 14;
+            fftScratch[i] = static_cast<int16_t>(fl::clamp(v, (int32_t)-32768, (int32_t)32767));
         }
+    }
 
+    inline uint32_t fftSampleRate() {
         int sampleRate = fl::audio::fft::Args::DefaultSampleRate();
         if (config.is<fl::audio::ConfigI2S>()) {
             sampleRate = static_cast<int>(config.get<fl::audio::ConfigI2S>().mSampleRate);
         } else if (config.is<fl::audio::ConfigPdm>()) {
             sampleRate = static_cast<int>(config.get<fl::audio::ConfigPdm>().mSampleRate);
         }
+        return static_cast<uint32_t>(sampleRate);
+    }
 
+    // fl::audio::fft on fftScratch
+    const FftBands* runFloatFft(binConfig& b) {
         fl::audio::fft::Args args(
-            static_cast<int>(wantN),
+            static_cast<int>(fftWindowSamples),
             b.NUM_FFT_BINS,
             FFT_MIN_FREQ,
             FFT_MAX_FREQ,
-            sampleRate
+            static_cast<int>(fftSampleRate())
         );
 
-        fl::span<const fl::i16> span(reinterpret_cast<const fl::i16*>(fftWindow), wantN);
+        fl::span<const fl::i16> span(reinterpret_cast<const fl::i16*>(fftScratch), fftWindowSamples);
         fftEngine.run(span, &fftBins, args);
-        return &fftBins;
+
+        const size_t rawN = fftBins.raw().size();
+        const size_t dbN = fftBins.db().size();
+        fftBands.count = static_cast<uint8_t>(FL_MIN(dbN, (size_t)MAX_FFT_BINS));
+        for (uint8_t i = 0; i < fftBands.count; i++) {
+            fftBands.raw[i] = (i < rawN) ? fftBins.raw()[i] : 0.0f;
+            fftBands.db[i] = fftBins.db()[i];
+        }
+        return &fftBands;
+    }
+
+    // Q15 radix-4 backend on fftScratch (see fftQ15.h)
+    const FftBands* runFixedFft(binConfig& b) {
+        return fftq15::run(fftScratch, fftWindowSamples, b.NUM_FFT_BINS, FFT_MIN_FREQ, FFT_MAX_FREQ, fftSampleRate());
+    }
+
+    // Spectrum of the current ring contents through the selected backend
+    const FftBands* runFft(binConfig& b) {
+
+        // Not enough history yet (startup). We can still run FFT on a partially-zero window,
+        // but returning nullptr makes downstream "valid" checks more predictable.
+        if (fftRingValid < fftWindowSamples / 2) {
+            return nullptr;
+        }
+
+        unwrapFftWindow();
+        const FftBands* bands = fixedFft ? runFixedFft(b) : runFloatFft(b);
+
+        // Mel/chroma read the Q15 transform's bins; the float path doesn't expose its own
+        if (melChroma) {
+            if (!fixedFft) fftq15::transform(fftScratch, fftWindowSamples);
+            updateMelChroma(fftWindowSamples, fftSampleRate());
+        }
+        return bands;
+    }
+
+    // Whole-block form: appends the newest filtered block and analyses once
+    const FftBands* getFFT(binConfig& b) {
+        if (!filteredSample.isValid()) return nullptr;
+
+        const auto &pcm = filteredSample.pcm();
+        if (pcm.size() == 0) return nullptr;
+
+        pushFftSamples(pcm.data(), pcm.size());
+        return runFft(b);
     }
 
-    const fl::audio::fft::Bins* getFFT_direct(binConfig& b) {
+    const FftBands* getFFT_direct(binConfig& b) {
         return getFFT(b);
     }
 
+    //=====================================================================
+    // Runtime FFT settings (BLE: inFftSize, inSampleRate, inFftBins)
+    //
+    // Applied by the analysis side at the top of each capture, so the ring,
+    // window and input are only touched by the thread that uses them. A new
+    // window length keeps the ring (it always holds FFT_MAX_WINDOW_SAMPLES);
+    // its Hann/Q15 tables are built once, on the first spectrum after the change.
+    // A new sample rate restarts the input and refills the ring.
+    //=====================================================================
+
+    constexpr uint32_t FFT_SAMPLE_RATES[] = { 16000, 22050, 32000, 44100, 48000 };
+
+    inline uint16_t snapFftSize(uint16_t n) {
+        if (n < 768) return FFT_MIN_WINDOW_SAMPLES;
+        if (n < 1536) return 1024;
+        return FFT_MAX_WINDOW_SAMPLES;
+    }
+
+    inline uint32_t snapSampleRate(uint32_t rate) {
+        uint32_t best = FFT_SAMPLE_RATES[0];
+        for (uint32_t r : FFT_SAMPLE_RATES) {
+            const uint32_t d = (r > rate) ? r - rate : rate - r;
+            const uint32_t bestD = (best > rate) ? best - rate : rate - best;
+            if (d < bestD) best = r;
+        }
+        return best;
+    }
+
+    inline void applyFftSettings() {
+        fftWindowSamples = snapFftSize(cFftSize);
+        bin32.NUM_FFT_BINS = fl::clamp<uint8_t>(cFftBins, 16, MAX_FFT_BINS);
+
+        // Only a changed request restarts the input: at boot (and in the host
+        // replay, where config follows the WAV file) the input is left as built.
+        // requestedRate moves only once the input runs at the new rate, so a
+        // failed restart is retried (at most every RESTART_RETRY_MS) rather than
+        // being taken as done.
+        constexpr uint32_t RESTART_RETRY_MS = 2000;
+        static uint32_t requestedRate = 0;
+        static uint32_t retryAfterMs = 0;
+        const uint32_t rate = snapSampleRate(cSampleRate);
+        if (requestedRate == 0 || rate == fftSampleRate()) {
+            requestedRate = rate;
+        } else if (rate != requestedRate && (int32_t)(fl::millis() - retryAfterMs) >= 0) {
+            if (restartAudioInput(rate)) {
+                requestedRate = rate;
+                fftRingValid = 0;
+                filteredSample = fl::audio::Sample();
+            } else {
+                retryAfterMs = fl::millis() + RESTART_RETRY_MS;
+            }
+        }
+    }
+
 } // namespace myAudio
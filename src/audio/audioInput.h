@@ -69,6 +69,68 @@ namespace myAudio {
 
     } // initAudioInput
 
+    // Created and started, or null (with errorMsg) if either step failed
+    fl::shared_ptr<fl::audio::IInput> startAudioInput(const fl::audio::Config& cfg, fl::string& errorMsg) {
+        fl::shared_ptr<fl::audio::IInput> input = fl::audio::IInput::create(cfg, &errorMsg);
+        if (!input) return input;
+        input->start();
+        if (input->error(&errorMsg)) {
+            input->stop();
+            input.reset();
+        }
+        return input;
+    }
+
+    // Rebuild the input at a new sample rate (BLE inSampleRate). Unlike
+    // initAudioInput() there is no power-up wait: the mic is already running.
+    // The I2S port can't hold two inputs, so the old one is released first;
+    // config only changes once the new input runs, and on failure the previous
+    // input is rebuilt from it, so fftSampleRate() always matches the mic.
+    bool restartAudioInput(uint32_t sampleRate) {
+        #if defined(AURORA_HOST)
+            (void)sampleRate;
+            return false;
+        #else
+            const fl::audio::Config next = fl::audio::Config::CreateIcs43434(
+                I2S_WS_PIN, I2S_SD_PIN, I2S_CLK_PIN,
+                fl::audio::AudioChannel::Left,
+                sampleRate
+            );
+
+            if (audioSource) {
+                audioSource->stop();
+                audioSource.reset();
+            }
+            audioInputInitialized = false;
+
+            fl::string errorMsg;
+            fl::shared_ptr<fl::audio::IInput> input = startAudioInput(next, errorMsg);
+            if (!input) {
+                Serial.print("Audio restart at ");
+                Serial.print(sampleRate);
+                Serial.print(" Hz failed: ");
+                Serial.println(errorMsg.c_str());
+
+                fl::string restoreMsg;
+                audioSource = startAudioInput(config, restoreMsg);
+                audioInputInitialized = (bool)audioSource;
+                if (!audioSource) {
+                    Serial.print("Could not restore audio input: ");
+                    Serial.println(restoreMsg.c_str());
+                }
+                return false;
+            }
+
+            config = next;
+            audioSource = input;
+            Serial.print("Audio input restarted at ");
+            Serial.print(sampleRate);
+            Serial.println(" Hz");
+            audioInputInitialized = true;
+            return true;
+        #endif
+    }
+
     void checkAudioInput() {
   
         // Check if audio source is valid
@@ -8,6 +8,9 @@
 
 #include "audioCapture.h"   // transitively includes audioTypes.h, audioInput.h
 #include "avHelpers.h"
+#include "tempoTracker.h"
+#include "audioTask.h"
+#include "featureHistory.h"
 #include "parameterSchema.h"
 
 namespace myAudio {
@@ -551,6 +554,10 @@ namespace myAudio {
 
         // *** STAGE: set current AudioVizConfig parameters
         updateVizConfig();
+        applyFftSettings();
+
+        // The snapshot is rewritten in place: handles to the previous one go stale
+        frame.generation++;
 
         // Per-render-frame latch reset (NOT per drained buffer).
         busA.newBeat = false;  busA.relativeIncrease = 0.0f;
@@ -561,6 +568,7 @@ namespace myAudio {
         frame.valid = filteredSample.isValid();
         frame.timestamp = currentSample.timestamp();
         frame.pcm = filteredSample.pcm();
+        frame.numBins = b.NUM_FFT_BINS;     // render sizes its loops by this, not bin32
 
         if (!audioSource) {
             currentSample = fl::audio::Sample();
@@ -643,7 +651,7 @@ namespace myAudio {
 
         if (readCount > 0) {
             static uint32_t lastAudioTimestamp = 0;
-            static const fl::audio::fft::Bins* lastFft = nullptr;
+            static const FftBands* lastFft = nullptr;
             static bool prevGateForBus = false;
             static float rmsCrossCalEMA = 0.0f;
 
@@ -682,21 +690,12 @@ namespace myAudio {
                 frame.timestamp = currentSample.timestamp();
                 frame.pcm = filteredSample.pcm();
 
-                const fl::audio::fft::Bins* fftForBeat = nullptr;
                 float rmsNormFast = 0.0f;
                 float rmsPostFloorFast = 0.0f;
                 float gainAppliedLevel = 1.0f;
                 float gainAppliedFft = 1.0f;
 
                 if (frame.valid) {
-                    if (frame.timestamp != lastFftTimestamp) {
-                        fftForBeat = getFFT(b);
-                        lastFftTimestamp = frame.timestamp;
-                        lastFft = fftForBeat;
-                    } else {
-                        fftForBeat = lastFft;
-                    }
-
                     frame.rms_raw = filteredSample.rms(); // no temporal smoothing
                     rmsNormFast = frame.rms_raw / 32768.0f;
                     rmsNormFast = fl::clamp(rmsNormFast, 0.0f, 1.0f);
@@ -719,60 +718,102 @@ namespace myAudio {
                 }
 
                 lastGainAppliedLevel = gainAppliedLevel;
-                frame.fft = fftForBeat;
 
-                // --- FFT bins: visualization (dB-linear) + bus beat detection (true linear) ---
-                if (frame.valid) {
-                    frame.fft_norm_valid = false;
-                    if (frame.fft && frame.fft->db().size() > 0) {
-                        for (uint8_t i = 0; i < b.NUM_FFT_BINS; i++) {
-                            // Visualization path: dB-linear scale
-                            float mag_db = 0.0f;
-                            if (i < frame.fft->db().size()) {
-                                mag_db = frame.fft->db()[i] / 100.0f;
-                            }
-                            mag_db = FL_MAX(0.0f, mag_db - vizConfig.audioFloorFft);
-                            frame.fft_norm[i] = fl::clamp(mag_db * gainAppliedFft, 0.0f, 1.0f);
+                // --- One spectrum + bus update per hop within this block ---
+                // A hop pushes its slice into the FFT ring and analyses the window
+                // ending there; timestamp and dt are those of the slice's last sample.
+                const fl::span<const int16_t> blockPcm = filteredSample.pcm();
+                const bool newBlock = frame.valid && blockPcm.size() > 0 && frame.timestamp != lastFftTimestamp;
+                const size_t blockN = blockPcm.size();
+                const uint16_t hopN = fftHop(blockN);
+                const uint32_t blockTs = frame.timestamp;
+                const float msPerSample = (blockN > 0) ? dtMs / blockN : 0.0f;
+                size_t hopStart = 0;
+
+                do {
+                    const FftBands* fftForBeat = nullptr;
+                    size_t hopEnd = blockN;
+                    float hopDtMs = dtMs;
+
+                    if (newBlock) {
+                        hopEnd = FL_MIN(blockN, hopStart + hopN);
+                        hopDtMs = msPerSample * (hopEnd - hopStart);
+                        frame.timestamp = blockTs - static_cast<uint32_t>(msPerSample * (blockN - hopEnd));
+                        pushFftSamples(blockPcm.data() + hopStart, hopEnd - hopStart);
+                        fftForBeat = runFft(b);
+                        lastFft = fftForBeat;
+                        publishMelChroma(frame, melChroma && fftForBeat != nullptr);
+                    } else if (frame.valid) {
+                        fftForBeat = lastFft;
+                    }
 
-                            // Beat detection path: true linear magnitude
-                            float mag_lin = 0.0f;
-                            if (i < frame.fft->raw().size()) {
-                                mag_lin = frame.fft->raw()[i] / 32768.0f;
+                    frame.fft = fftForBeat;
+
+                    // --- FFT bins: visualization (dB-linear) + bus beat detection (true linear) ---
+                    if (frame.valid) {
+                        frame.fft_norm_valid = false;
+                        if (frame.fft && frame.fft->count > 0) {
+                            for (uint8_t i = 0; i < b.NUM_FFT_BINS; i++) {
+                                // Visualization path: dB-linear scale
+                                float mag_db = 0.0f;
+                                if (i < frame.fft->count) {
+                                    mag_db = frame.fft->db[i] / 100.0f;
+                                }
+                                mag_db = FL_MAX(0.0f, mag_db - vizConfig.audioFloorFft);
+                                frame.fft_norm[i] = fl::clamp(mag_db * gainAppliedFft, 0.0f, 1.0f);
+
+                                // Beat detection path: true linear magnitude
+                                float mag_lin = 0.0f;
+                                if (i < frame.fft->count) {
+                                    mag_lin = frame.fft->raw[i] / 32768.0f;
+                                }
+                                frame.fft_pre[i] = fl::clamp(mag_lin, 0.0f, 1.0f);
                             }
-                            frame.fft_pre[i] = fl::clamp(mag_lin, 0.0f, 1.0f);
-                        }
-                        for (uint8_t i = b.NUM_FFT_BINS; i < MAX_FFT_BINS; i++) {
-                            frame.fft_pre[i] = 0.0f;
-                            frame.fft_norm[i] = 0.0f;
+                            for (uint8_t i = b.NUM_FFT_BINS; i < MAX_FFT_BINS; i++) {
+                                frame.fft_pre[i] = 0.0f;
+                                frame.fft_norm[i] = 0.0f;
+                            }
+                            frame.fft_norm_valid = true;
+                        } else {
+                            for (uint8_t i = 0; i < MAX_FFT_BINS; i++) {
+                                frame.fft_pre[i] = 0.0f;
+                                frame.fft_norm[i] = 0.0f;
+                            }
+                            frame.fft_norm_valid = false;
                         }
-                        frame.fft_norm_valid = true;
                     } else {
+                        frame.fft = nullptr;
+                        frame.fft_norm_valid = false;
                         for (uint8_t i = 0; i < MAX_FFT_BINS; i++) {
                             frame.fft_pre[i] = 0.0f;
                             frame.fft_norm[i] = 0.0f;
                         }
-                        frame.fft_norm_valid = false;
                     }
-                } else {
-                    frame.fft = nullptr;
-                    frame.fft_norm_valid = false;
-                    for (uint8_t i = 0; i < MAX_FFT_BINS; i++) {
-                        frame.fft_pre[i] = 0.0f;
-                        frame.fft_norm[i] = 0.0f;
+
+                    // Onset/tempo: once per fresh spectrum, clocked by sample count
+                    // (block timestamps jitter with DMA draining)
+                    if (newBlock) {
+                        updateTempo(frame.fft_norm_valid ? frame.fft_pre : nullptr, b.NUM_FFT_BINS,
+                                    static_cast<uint16_t>(hopEnd - hopStart), fftSampleRate());
                     }
-                }
 
-                if (b.busBased) {
-                    // Phase 1: spectrally-flattened values
-                    updateBus(frame, b, busA, dtMs);
-                    updateBus(frame, b, busB, dtMs);
-                    updateBus(frame, b, busC, dtMs);
-
-                    // Phase 2: RMS-domain cross-cal + visualization gain
-                    finalizeBus(frame, busA, rmsPostFloorFast, gainAppliedLevel, dtMs);
-                    finalizeBus(frame, busB, rmsPostFloorFast, gainAppliedLevel, dtMs);
-                    finalizeBus(frame, busC, rmsPostFloorFast, gainAppliedLevel, dtMs);
-                }
+                    if (b.busBased) {
+                        // Phase 1: spectrally-flattened values
+                        updateBus(frame, b, busA, hopDtMs);
+                        updateBus(frame, b, busB, hopDtMs);
+                        updateBus(frame, b, busC, hopDtMs);
+
+                        // Phase 2: RMS-domain cross-cal + visualization gain
+                        finalizeBus(frame, busA, rmsPostFloorFast, gainAppliedLevel, hopDtMs);
+                        finalizeBus(frame, busB, rmsPostFloorFast, gainAppliedLevel, hopDtMs);
+                        finalizeBus(frame, busC, rmsPostFloorFast, gainAppliedLevel, hopDtMs);
+                    }
+
+                    hopStart = hopEnd;
+                } while (hopStart < blockN);
+
+                if (newBlock) lastFftTimestamp = blockTs;
+                frame.timestamp = blockTs;
             }
 
             // FastLED AudioProcessor: update once per render frame using the newest buffer.
@@ -802,6 +843,8 @@ namespace myAudio {
             frame.rms_factor = 0.0f;
         }
 
+        publishTempo(frame);
+
         if (b.busBased) {
             frame.busA = busA;
             frame.busB = busB;
@@ -820,10 +863,11 @@ namespace myAudio {
     } // captureAudioFrame()
 
     //=====================================================================
-    // Frame cache — one snapshot per loop iteration
+    // Frame cache — one snapshot per loop iteration (a handle to
+    // captureAudioFrame()'s frame, never a copy of it)
     //=====================================================================
 
-    AudioFrame gAudioFrame;
+    AudioFrameHandle gAudioFrame;
     bool gAudioFrameInitialized = false;
     uint32_t gAudioFrameLastMs = 0;
     //bool audioLatencyDiagnostics = true;
@@ -838,12 +882,14 @@ namespace myAudio {
         return sampleRate;
     }
 
-    inline const AudioFrame& updateAudioFrame(binConfig& b) {
+    // Capture + analysis for whatever DMA blocks are waiting; runs on the audio task
+    // when it's up, otherwise inline from updateAudioFrame()
+    inline const AudioFrame& processAudioFrame(binConfig& b) {
         uint32_t now = fl::millis();
 
         if (gAudioFrameInitialized && now == gAudioFrameLastMs) {
-            if (gAudioFrame.fft_norm_valid) {
-                return gAudioFrame;
+            if (gAudioFrame->fft_norm_valid) {
+                return *gAudioFrame;
             }
         }
 
@@ -945,21 +991,38 @@ namespace myAudio {
                                 << " | pcm " << stats.lastPcmSamples
                                 << " (" << pcmMs << " ms) sr " << stats.lastSampleRate
                                 << " | gate " << (noiseGateOpen ? 1 : 0)
-                                << " | invalid " << stats.invalidCount);
+                                << " | invalid " << stats.invalidCount
+                                << " | av lead " << avSync.leadMs
+                                << " (capture " << avSync.captureMs
+                                << " render " << avSync.renderMs
+                                << " output " << avSync.outputMs
+                                << ") bpm " << (avSync.periodMs > 0.0f ? 60000.0f / avSync.periodMs : 0.0f));
 
                 stats = LatencyStats();
                 stats.windowStartMs = now;
             }
         } // if (audioLatencyDiagnostics)
 
-        gAudioFrame = frame;
+        gAudioFrame = AudioFrameHandle(frame);
         gAudioFrameInitialized = true;
         gAudioFrameLastMs = now;
 
-        return gAudioFrame;
+        return frame;
     }
 
-    inline const AudioFrame& getAudioFrame() {
+    // Single entry point for programs: a handle to the newest analysed frame
+    inline AudioFrameHandle updateAudioFrame(binConfig& b) {
+        const AudioFrame& frame = audioTask::running ? audioTask::latest(b) : processAudioFrame(b);
+        noteAudioRead(frame);
+        recordFeatureHistory(frame, frame.numBins);
+        return AudioFrameHandle(frame);
+    }
+
+    // The frame the render side last picked up (doesn't advance to a newer one)
+    inline AudioFrameHandle getAudioFrame() {
+        if (audioTask::running) {
+            return AudioFrameHandle(audioTask::frames.current());
+        }
         return gAudioFrame;
     }
 
@@ -1028,8 +1091,8 @@ namespace myAudio {
     //=====================================================================
 
     void printDiagnostics() {
-        const auto& f = gAudioFrame;
-        uint8_t limit = maxBins ? bin32.NUM_FFT_BINS : bin16.NUM_FFT_BINS;
+        const AudioFrame& f = getAudioFrame();
+        uint8_t limit = f.numBins;
         
         /*
         FASTLED_DBG("rmsRaw " << (f.rms_raw / 32768.0f)
@@ -1075,7 +1138,7 @@ namespace myAudio {
     }
 
     void printBusSettings () {
-        const auto& f = gAudioFrame;
+        const AudioFrame& f = getAudioFrame();
         FASTLED_DBG("busA.thresh " << f.busA.threshold);
         FASTLED_DBG("busA.minBeatInt " << f.busA.minBeatInterval);
         FASTLED_DBG("busA.peakBase " << f.busA.peakBase);
@@ -0,0 +1,169 @@
+#pragma once
+
+// =====================================================
+// audioTask.h — Audio analysis off the render thread.
+// A task pinned to the other core runs the capture →
+// filter → FFT → bus pipeline as DMA blocks arrive and
+// publishes AudioFrames through a lock-free triple
+// buffer. updateAudioFrame() on the render side just
+// picks up the newest one.
+// =====================================================
+
+#include <atomic>
+#include "audioTypes.h"
+
+#if !defined(AURORA_HOST)
+    #include "freertos/FreeRTOS.h"
+    #include "freertos/task.h"
+#endif
+
+namespace myAudio {
+
+    inline const AudioFrame& processAudioFrame(binConfig& b);   // audioProcessing.h
+
+    //=====================================================================
+    // AudioFrameBuffer — single-writer / single-reader triple buffer
+    //
+    // The writer fills `back`, then swaps it into `middle` with FRESH set. The
+    // reader swaps `middle` into `front` only when FRESH is set. Neither side
+    // ever waits, and a frame is never modified while the reader holds it.
+    //
+    // Each slot carries its own PCM copy; frame.pcm points at it and frame.fft
+    // is cleared, because the live FFT bins are reused by the next block.
+    // Bus newBeat flags are sticky across frames the reader never picked up,
+    // so a 20 fps renderer still sees every beat the ~86 Hz analysis found.
+    //=====================================================================
+
+    class AudioFrameBuffer {
+    public:
+        // Writer side (audio task)
+        void publish(const AudioFrame& src) {
+            Slot& s = slots[back];
+            s.frame = src;
+            const size_t n = FL_MIN(src.pcm.size(), (size_t)PCM_CAP);
+            for (size_t i = 0; i < n; i++) s.pcm[i] = src.pcm[i];
+            s.frame.pcm = fl::span<const int16_t>(s.pcm, n);
+            s.frame.fft = nullptr;
+
+            const bool beat[3] = { src.busA.newBeat, src.busB.newBeat, src.busC.newBeat };
+            uint8_t m = middle.load(std::memory_order_acquire);
+            for (;;) {
+                // Reader took the last publish: its beats were delivered
+                if (!(m & FRESH)) pendingBeat[0] = pendingBeat[1] = pendingBeat[2] = false;
+                s.frame.busA.newBeat = beat[0] || pendingBeat[0];
+                s.frame.busB.newBeat = beat[1] || pendingBeat[1];
+                s.frame.busC.newBeat = beat[2] || pendingBeat[2];
+                // Fails (and reloads m) if the reader swapped in between
+                if (middle.compare_exchange_weak(m, (uint8_t)(back | FRESH),
+                                                 std::memory_order_acq_rel,
+                                                 std::memory_order_acquire)) {
+                    break;
+                }
+            }
+            pendingBeat[0] = s.frame.busA.newBeat;
+            pendingBeat[1] = s.frame.busB.newBeat;
+            pendingBeat[2] = s.frame.busC.newBeat;
+            back = m & INDEX;
+            published = true;
+        }
+
+        // Reader side (render thread); the reference stays valid until the next read()
+        const AudioFrame& read() {
+            if (middle.load(std::memory_order_relaxed) & FRESH) {
+                front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+            }
+            return slots[front].frame;
+        }
+
+        // Reader side: the frame the last read() picked up, without swapping
+        const AudioFrame& current() const { return slots[front].frame; }
+
+        bool hasFrame() const { return published; }
+
+    private:
+        static constexpr uint8_t FRESH = 0x80;
+        static constexpr uint8_t INDEX = 0x03;
+        static constexpr uint16_t PCM_CAP = sizeof(filteredPcmBuffer) / sizeof(filteredPcmBuffer[0]);
+
+        struct Slot {
+            AudioFrame frame;
+            int16_t pcm[PCM_CAP];
+        };
+
+        Slot slots[3];
+        uint8_t back = 0;                       // writer only
+        uint8_t front = 1;                      // reader only
+        std::atomic<uint8_t> middle{2};         // shared: index | FRESH
+        bool pendingBeat[3] = { false, false, false };
+        volatile bool published = false;
+    };
+
+    //=====================================================================
+    // audioTask — capture/analysis loop on the non-render core
+    //
+    // fl::audio::IInput doesn't expose the I2S DMA event, so the task polls
+    // readAll() every POLL_MS (under half a 512-sample block at 44.1 kHz). A block
+    // is analysed within a few ms of arriving, whatever the render fps.
+    // The host build has no task: updateAudioFrame() stays inline and deterministic.
+    //=====================================================================
+
+    namespace audioTask {
+
+        bool enabled = true;                    // false = analyse inline on the render thread
+        bool running = false;
+        AudioFrameBuffer frames;
+        std::atomic<binConfig*> bins{nullptr};  // bin layout the renderer last asked for
+
+        constexpr uint32_t POLL_MS = 5;
+
+        #if defined(AURORA_HOST)
+
+            bool start() { return false; }
+
+        #else
+
+            TaskHandle_t handle = nullptr;
+
+            void taskLoop(void*) {
+                for (;;) {
+                    binConfig* b = bins.load(std::memory_order_acquire);
+                    if (b) {
+                        const AudioFrame& frame = processAudioFrame(*b);
+                        if (lastAudioBuffersDrained > 0 || !frames.hasFrame()) {
+                            frames.publish(frame);
+                        }
+                    }
+                    vTaskDelay(pdMS_TO_TICKS(POLL_MS));
+                }
+            }
+
+            bool start() {
+                // Above loop/render priority: analysis is short and latency-sensitive
+                const BaseType_t otherCore = 1 - xPortGetCoreID();
+                return xTaskCreatePinnedToCore(taskLoop, "audioTask", 8192, nullptr,
+                                               3, &handle, otherCore) == pdPASS;
+            }
+
+        #endif
+
+        // Called once from setup() after the audio input and pipeline are initialised
+        void begin() {
+            if (!enabled || running) return;
+            running = start();
+            if (!running) {
+                enabled = false;
+                #if !defined(AURORA_HOST)
+                    Serial.println("audioTask: could not start task, analysing on the render thread");
+                #endif
+            }
+        }
+
+        // Render side: newest published frame for this bin layout (never blocks)
+        const AudioFrame& latest(binConfig& b) {
+            bins.store(&b, std::memory_order_release);
+            return frames.read();
+        }
+
+    } // namespace audioTask
+
+} // namespace myAudio
@@ -51,15 +51,26 @@ namespace myAudio {
 
     constexpr uint8_t MAX_FFT_BINS = 32;
 
-    // FFT window length (in samples) used for spectral analysis.
-    // Note: input DMA blocks are currently 512 samples; we build a 1024-sample
-    // window from the most recent filtered audio for better low-frequency bin coverage.
-    constexpr uint16_t FFT_WINDOW_SAMPLES = 1024;
+    // FFT window length (in samples) used for spectral analysis. Selected at runtime
+    // (cFftSize: 512 / 1024 / 2048, see applyFftSettings()); the max sizes the buffers.
+    // Note: input DMA blocks are currently 512 samples; a 1024-sample window built
+    // from the most recent filtered audio gives better low-frequency bin coverage,
+    // 2048 better still, at the cost of a longer (later-peaking) window.
+    constexpr uint16_t FFT_MIN_WINDOW_SAMPLES = 512;
+    constexpr uint16_t FFT_MAX_WINDOW_SAMPLES = 2048;
+    uint16_t fftWindowSamples = 1024;
+    // Samples between successive spectra. 512 = one FFT per DMA block (50% overlap);
+    // 256 halves the onset latency of the bus beat detectors at twice the FFT cost.
+    // Clamped to [FFT_MIN_HOP_SAMPLES, block size] when the block is cut up.
+    constexpr uint16_t FFT_MIN_HOP_SAMPLES = 64;
+    uint16_t fftHopSamples = 512;
     // FFT band range (log-spaced). Tuned for 44.1kHz + 1024-sample FFT window.
     // Targets musical coverage ~60Hz–5kHz while avoiding "empty" LOG_REBIN bins.
     constexpr float FFT_MIN_FREQ = 63.f;
     constexpr float FFT_MAX_FREQ = 5000.f;
     constexpr uint8_t NUM_BUSES = 3;
+    constexpr uint8_t NUM_MEL_BANDS = 24;   // filterbank.h
+    constexpr uint8_t NUM_CHROMA = 12;
 
     // Scale factors: single user control → domain-specific internal values
     // Level (RMS) values are tiny (~0.001-0.02), FFT/dB values are larger (~0.1-0.8)
@@ -80,9 +91,10 @@ namespace myAudio {
     binConfig bin16;
     binConfig bin32;
 
+    // bin32 is the wide layout; cFftBins resizes it at runtime (16..MAX_FFT_BINS)
     void setBinConfig() {
         bin16.NUM_FFT_BINS = 16;
-        bin32.NUM_FFT_BINS = 32;
+        bin32.NUM_FFT_BINS = MAX_FFT_BINS;
     }
 
     //=====================================================================
@@ -256,11 +268,23 @@ namespace myAudio {
     AudioVizConfig vizConfig;
     float avLevelerValue = 1.0f;
 
+    //=====================================================================
+    // FftBands — per-band spectrum as the pipeline consumes it, whichever
+    // FFT backend produced it (fl float path or fftq15)
+    //=====================================================================
+
+    struct FftBands {
+        uint8_t count = 0;
+        float raw[MAX_FFT_BINS] = {0};      // linear magnitude, int16 full scale ≈ 32768
+        float db[MAX_FFT_BINS] = {0};       // dB (pipeline divides by 100)
+    };
+
     //=====================================================================
     // AudioFrame — per-frame snapshot of all audio data
     //=====================================================================
 
     struct AudioFrame {
+        uint32_t generation = 0;            // bumped each time this storage is rewritten
         bool valid = false;
         uint32_t timestamp = 0;
         float rms_raw = 0.0f;
@@ -275,16 +299,61 @@ namespace myAudio {
         float scaledVoxConf = 0.0f;
         float voxApprox = 0.0f;
 
-        const fl::audio::fft::Bins* fft = nullptr;
+        const FftBands* fft = nullptr;
         bool fft_norm_valid = false;
+        uint8_t numBins = 0;                // bins used for fft_pre/fft_norm (cFftBins can change)
         float fft_pre[MAX_FFT_BINS] = {0};
         float fft_norm[MAX_FFT_BINS] = {0};
         fl::span<const int16_t> pcm;
+
+        // Tempo (tempoTracker.h)
+        float onset = 0.0f;                 // spectral flux of the newest hop
+        float tempoConfidence = 0.0f;       // [0, 1]
+        float bpm = 0.0f;                   // 0 = no tempo lock
+        float beatPhase = 0.0f;             // [0, 1) at timestamp; 0 = on the beat
+        uint32_t nextBeatMs = 0;            // predicted next beat, same clock as timestamp
+
+        // Mel bands / chroma (filterbank.h, melChroma only)
+        bool melChromaValid = false;
+        float mel[NUM_MEL_BANDS] = {0};     // 40 Hz–8 kHz, linear (fft_pre scale)
+        float chroma[NUM_CHROMA] = {0};     // pitch classes C..B, strongest = 1
+
         Bus busA;
         Bus busB;
         Bus busC;
     };
 
+    const AudioFrame noAudioFrame{};
+
+    //=====================================================================
+    // AudioFrameHandle — read-only reference to a published AudioFrame
+    //
+    // Consumers hold a handle instead of copying the frame (or its buses).
+    // The handle remembers the frame's generation when it was taken;
+    // current() turns false once the producer has rewritten that storage.
+    // A handle from updateAudioFrame() stays current at least until the
+    // next updateAudioFrame() call, so take one per render frame and pass
+    // it (or the reference) to everything that needs audio that frame.
+    //=====================================================================
+
+    class AudioFrameHandle {
+    public:
+        AudioFrameHandle() = default;
+        explicit AudioFrameHandle(const AudioFrame& f) : frame(&f), gen(f.generation) {}
+
+        const AudioFrame& get() const { return frame ? *frame : noAudioFrame; }
+        const AudioFrame& operator*() const { return get(); }
+        const AudioFrame* operator->() const { return &get(); }
+        operator const AudioFrame&() const { return get(); }
+
+        uint32_t generation() const { return gen; }
+        bool current() const { return frame && frame->generation == gen; }
+
+    private:
+        const AudioFrame* frame = nullptr;
+        uint32_t gen = 0;
+    };
+
     //=====================================================================
     // Core audio objects
     //=====================================================================
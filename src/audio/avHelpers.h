@@ -7,9 +7,133 @@
 
 namespace myAudio {
 
+    //=====================================================================
+    // AvSync — pipeline latency, measured on the render side
+    //
+    // A response started at frame time t (frame.timestamp, the end of the
+    // newest hop) reaches the LEDs at about t + leadMs:
+    //   captureMs  hop end -> renderer picks the frame up   (noteAudioRead)
+    //   renderMs   pick-up -> showPipeline::present()       (notePresented)
+    //   outputMs   present() -> frame fully sent            (showPipeline)
+    // Frame timestamps and fl::millis() share a clock (the host replay
+    // stamps blocks the same way).
+    //=====================================================================
+
+    struct AvSync {
+        float captureMs = 0.0f;
+        float renderMs = 0.0f;
+        float outputMs = 0.0f;
+        float leadMs = 0.0f;
+        uint32_t readMs = 0;        // render clock at the last frame pick-up (0 = none pending)
+
+        // Tempo as of the last frame picked up
+        float periodMs = 0.0f;      // 0 = no tempo lock
+        uint32_t nextBeatMs = 0;
+    };
+
+    AvSync avSync;
+
+    inline void noteAudioRead(const AudioFrame& frame) {
+        const uint32_t now = fl::millis();
+        if (frame.valid) {
+            const int32_t dt = static_cast<int32_t>(now - frame.timestamp);
+            if (dt >= 0 && dt < 1000) avSync.captureMs += 0.05f * (dt - avSync.captureMs);
+        }
+        avSync.readMs = now;
+        avSync.periodMs = (frame.valid && frame.bpm > 0.0f) ? 60000.0f / frame.bpm : 0.0f;
+        avSync.nextBeatMs = frame.nextBeatMs;
+    }
+
+    // From loop(), right after showPipeline::present()
+    inline void notePresented(float outputMs) {
+        if (avSync.readMs != 0) {
+            const uint32_t dt = fl::millis() - avSync.readMs;
+            if (dt < 1000) avSync.renderMs += 0.1f * (dt - avSync.renderMs);
+            avSync.readMs = 0;
+        }
+        avSync.outputMs = outputMs;
+        avSync.leadMs = avSync.captureMs + avSync.renderMs + avSync.outputMs;
+    }
+
+    //=====================================================================
+    // Beat prediction — fire responses leadMs ahead of the tempo grid
+    //
+    // Each tempo beat is a slot. A bus onset within ±20% of a period of a
+    // slot is a hit, and hitScore follows the hit rate per slot. Buses that
+    // land on nearly every beat (a four-on-the-floor kick) fire at
+    // beat - leadMs, so the flash shows on the beat. When the real onset
+    // then arrives, it only refreshes the intensity. Buses that hit every
+    // other beat, or with no tempo lock, stay reactive as before.
+    //=====================================================================
+
+    struct BeatPredictor {
+        float hitScore = 0.0f;      // [0, 1] EMA of slots that got a real onset
+        float intensity = 0.0f;     // EMA of recent onset intensity, used for predicted fires
+        uint32_t slotMs = 0;        // beat currently tracked (frame clock), 0 = none
+        bool slotFired = false;
+        bool slotHit = false;
+    };
+
+    BeatPredictor beatPredictors[NUM_BUSES];
+
+    constexpr float PREDICT_MIN_HITS = 0.6f;
+    constexpr float PREDICT_WINDOW   = 0.2f;    // of a period
+    constexpr float PREDICT_MAX_LEAD = 0.4f;    // of a period
+
+    // True when the response should (re)start. startMs is the ramp start in the
+    // caller's clock, which may be slightly in the past for a predicted beat.
+    inline bool beatTrigger(const Bus& bus, uint32_t now, float& intensity, uint32_t& startMs) {
+        BeatPredictor& p = beatPredictors[bus.id];
+        const float onset = fl::clamp(bus.relativeIncrease - bus.threshold, 0.0f, 100.0f);
+        if (bus.newBeat) p.intensity += 0.3f * (onset - p.intensity);
+
+        const float period = avSync.periodMs;
+        if (!avPredict || period <= 0.0f || avSync.nextBeatMs == 0) {
+            p.hitScore = 0.0f;
+            p.slotMs = 0;
+            intensity = onset;
+            startMs = now;
+            return bus.newBeat;
+        }
+
+        // Current slot = tempo beat nearest to now
+        const uint32_t nextBeat = avSync.nextBeatMs;
+        const uint32_t prevBeat = nextBeat - static_cast<uint32_t>(period);
+        const uint32_t slot = (static_cast<int32_t>(now - prevBeat) < static_cast<int32_t>(nextBeat - now)) ? prevBeat : nextBeat;
+        const float window = PREDICT_WINDOW * period;
+        if (p.slotMs == 0 || fl::fabsf(static_cast<float>(static_cast<int32_t>(slot - p.slotMs))) > window) {
+            if (p.slotMs != 0) p.hitScore += 0.15f * ((p.slotHit ? 1.0f : 0.0f) - p.hitScore);
+            p.slotMs = slot;
+            p.slotFired = false;
+            p.slotHit = false;
+        }
+
+        if (bus.newBeat) {
+            const bool inSlot = fl::fabsf(static_cast<float>(static_cast<int32_t>(now - p.slotMs))) <= window;
+            if (inSlot) p.slotHit = true;
+            if (inSlot && p.slotFired) return false;        // already on its way out
+            if (inSlot) p.slotFired = true;
+            intensity = onset;
+            startMs = now;
+            return true;
+        }
+
+        const float lead = FL_MIN(avSync.leadMs, PREDICT_MAX_LEAD * period);
+        const uint32_t fireMs = p.slotMs - static_cast<uint32_t>(lead);
+        if (!p.slotFired && p.hitScore >= PREDICT_MIN_HITS && static_cast<int32_t>(now - fireMs) >= 0) {
+            p.slotFired = true;
+            intensity = p.intensity;
+            startMs = fireMs;
+            return true;
+        }
+        return false;
+    }
+
     // basicPulse: avResponse decays exponentially from 1.0
-    void basicPulse(Bus& bus){
-        if (bus.newBeat) { bus.avResponse = 1.0f;}
+    void basicPulse(Bus& bus, uint32_t now){
+        float intensity;
+        uint32_t startMs;
+        if (beatTrigger(bus, now, intensity, startMs)) { bus.avResponse = 1.0f;}
         if (bus.avResponse > .1f) {
             bus.avResponse = bus.avResponse * bus.expDecayFactor;  // Exponential decay
         } else {
@@ -18,8 +142,10 @@ namespace myAudio {
     }
 
 
-    // dynamicPulse: louder beat = faster rise, higher peak and longer fallTime
-    void dynamicPulse(Bus& bus, uint32_t now) {
+    // dynamicPulse: louder beat = faster rise, higher peak and longer fallTime.
+    // Only reads the bus: pass a published frame's bus, never myAudio::busA/B/C,
+    // which the audio task rewrites on the other core.
+    float dynamicPulse(const Bus& bus, uint32_t now) {
         // Each bus gets its own TimeRamp instance (static = persists across calls)
         static fl::TimeRamp ramps[NUM_BUSES] = {
             fl::TimeRamp(0, 0, 0),
@@ -30,8 +156,9 @@ namespace myAudio {
         fl::TimeRamp& ramp = ramps[bus.id];
         float& peak = peaks[bus.id];
 
-        if (bus.newBeat) {
-            float intensity = fl::clamp(bus.relativeIncrease - bus.threshold, 0.0f, 100.0f);
+        float intensity;
+        uint32_t startMs;
+        if (beatTrigger(bus, now, intensity, startMs)) {
             // Soft saturation: hyperbolic pre-normalize to [0,1), then easeOutCubic.
             // k=2 → 50% saturation at intensity=2; good dynamic range up to ~1.0,
             // barely noticeable above ~5. Both peak and fallingTime use the same
@@ -43,11 +170,11 @@ namespace myAudio {
             uint32_t risingTime = (uint32_t)(ease * bus.rampAttack);           // bus.rampAttack
             uint32_t fallingTime = (uint32_t)(10.0f + ease * bus.rampDecay);   // bus.rampDecay
             ramp = fl::TimeRamp(0, risingTime, fallingTime);
-            ramp.trigger(now);
+            ramp.trigger(startMs);
         }
 
         uint8_t currentAlpha = ramp.update8(now);
-        bus.avResponse = peak * currentAlpha / 255.0f;
+        return peak * currentAlpha / 255.0f;
     }
 
 
@@ -62,8 +189,9 @@ namespace myAudio {
         fl::TimeRamp& ramp = ramps[bus.id];
         float& peak = peaks[bus.id];
 
-        if (bus.newBeat) {
-            float intensity = fl::clamp(bus.relativeIncrease - bus.threshold, 0.0f, 100.0f);
+        float intensity;
+        uint32_t startMs;
+        if (beatTrigger(bus, now, intensity, startMs)) {
             // Soft saturation: hyperbolic pre-normalize to [0,1), then easeOutCubic.
             // k=2 → 50% saturation at intensity=2; good dynamic range up to ~1.0,
             // barely noticeable above ~5. Both peak and fallingTime use the same
@@ -75,7 +203,7 @@ namespace myAudio {
             uint32_t risingTime = (uint32_t)(ease * bus.rampAttack);           // bus.rampAttack
             uint32_t fallingTime = (uint32_t)(30.0f + ease * bus.rampDecay);   // bus.rampDecay
             ramp = fl::TimeRamp(0, risingTime, fallingTime);
-            ramp.trigger(now);
+            ramp.trigger(startMs);
         }
 
         uint8_t currentAlpha = ramp.update8(now);
@@ -94,7 +222,7 @@ namespace myAudio {
     // leadResponse: envelope follower on lead.energy with asymmetric attack/release.
     // Provides visual sustain for lead/vocal channel — rises quickly with new energy,
     // decays slowly so the visual doesn't drop out between phrases.
-    void leadResponse(Bus& bus) {
+    float leadResponse() {
         static float envelope = 0.0f;
 
         float input = lead.energy;
@@ -103,8 +231,7 @@ namespace myAudio {
 
         float alpha = (input > envelope) ? attack : release;
         envelope += alpha * (input - envelope);
-
-        bus.avResponse = envelope;
+        return envelope;
     }
 
 
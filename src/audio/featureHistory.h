@@ -0,0 +1,86 @@
+#pragma once
+
+// =====================================================
+// featureHistory.h — Recent audio features over time.
+// A fixed ring of the last HISTORY_LEN frames' fft_norm
+// vectors and bus envelopes. updateAudioFrame() appends
+// once per fresh frame (render side only), so time-axis
+// visualizers (spectrogram, waterfalls, trails) index
+// it by age instead of scrolling pixels.
+// =====================================================
+
+#include "audioTypes.h"
+
+namespace myAudio {
+
+    constexpr uint16_t HISTORY_LEN = 64;    // >= tallest panel (48 rows)
+
+    struct FeatureSnapshot {
+        uint32_t timestamp = 0;
+        uint8_t numBins = 0;
+        float fft_norm[MAX_FFT_BINS] = {0};
+        float busNorm[NUM_BUSES] = {0};     // Bus::normEMA
+        float busEnergy[NUM_BUSES] = {0};   // Bus::energyEMA
+        bool busBeat[NUM_BUSES] = {false};
+        float rms_norm = 0.0f;
+    };
+
+    //=====================================================================
+    // FeatureHistory — O(1) append, age-indexed reads (0 = newest)
+    //=====================================================================
+
+    class FeatureHistory {
+    public:
+        void push(const AudioFrame& frame, uint8_t numBins) {
+            head = (head + 1) % HISTORY_LEN;
+            FeatureSnapshot& s = entries[head];
+            s.timestamp = frame.timestamp;
+            s.numBins = numBins;
+            for (uint8_t i = 0; i < MAX_FFT_BINS; i++) s.fft_norm[i] = frame.fft_norm[i];
+            const Bus* buses[NUM_BUSES] = { &frame.busA, &frame.busB, &frame.busC };
+            for (uint8_t i = 0; i < NUM_BUSES; i++) {
+                s.busNorm[i] = buses[i]->normEMA;
+                s.busEnergy[i] = buses[i]->energyEMA;
+                s.busBeat[i] = buses[i]->newBeat;
+            }
+            s.rms_norm = frame.rms_norm;
+            if (count < HISTORY_LEN) count++;
+        }
+
+        uint16_t size() const { return count; }
+        void clear() { count = 0; }
+
+        // age must be < size()
+        const FeatureSnapshot& at(uint16_t age) const {
+            return entries[(head + HISTORY_LEN - age) % HISTORY_LEN];
+        }
+
+        // fft_norm at a fractional bin position, linearly interpolated
+        float sampleFft(uint16_t age, float binPos) const {
+            const FeatureSnapshot& s = at(age);
+            if (s.numBins == 0) return 0.0f;
+            binPos = fl::clamp(binPos, 0.0f, (float)(s.numBins - 1));
+            const uint8_t bin0 = static_cast<uint8_t>(binPos);
+            const uint8_t bin1 = (bin0 + 1 < s.numBins) ? (bin0 + 1) : bin0;
+            const float t = binPos - bin0;
+            return s.fft_norm[bin0] * (1.0f - t) + s.fft_norm[bin1] * t;
+        }
+
+        uint32_t lastGeneration = 0;        // generation of the newest frame pushed
+
+    private:
+        FeatureSnapshot entries[HISTORY_LEN];
+        uint16_t head = HISTORY_LEN - 1;
+        uint16_t count = 0;
+    };
+
+    FeatureHistory featureHistory;
+
+    // Appends each valid frame once, however many times it is read
+    inline void recordFeatureHistory(const AudioFrame& frame, uint8_t numBins) {
+        if (!frame.valid || frame.generation == featureHistory.lastGeneration) return;
+        featureHistory.lastGeneration = frame.generation;
+        featureHistory.push(frame, numBins);
+    }
+
+} // namespace myAudio
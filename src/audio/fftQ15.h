@@ -0,0 +1,265 @@
+#pragma once
+
+// =====================================================
+// fftQ15.h — Fixed-point FFT backend (optional).
+// N-point real FFT (N = 512/1024/2048) as an N/2-point
+// complex FFT (radix-4 stages, plus one radix-2 stage
+// when N/2 isn't a power of 4; Q15 twiddles, >>2 per
+// stage) and a real-split pass, then log-spaced
+// rebinning into NUM_FFT_BINS bands.
+// Selected with fixedFft (cx25); float path otherwise.
+// =====================================================
+
+#include "audioTypes.h"
+
+namespace myAudio {
+namespace fftq15 {
+
+    constexpr uint16_t M_MAX = FFT_MAX_WINDOW_SAMPLES / 2;
+
+    struct Cpx {
+        int16_t re;
+        int16_t im;
+    };
+
+    // Transform tables for the current length (rebuilt by plan() when it changes)
+    static uint16_t N = 0;              // real input length
+    static uint16_t M = 0;              // complex FFT length
+    static uint16_t R = 0;              // radix-4 sub-FFT length (M, or M/2 after a radix-2 split)
+    static Cpx twM[M_MAX];              // e^(-2πik/M), Q15
+    static Cpx twN[M_MAX];              // e^(-2πik/N), Q15 (real-split pass)
+    static uint16_t outIndex[M_MAX];    // digit-reversed position -> natural index
+
+    // Bin ranges per band for the current length/layout/rate (rebuilt by planBands())
+    struct BandPlan {
+        uint16_t n = 0;
+        uint8_t numBands = 0;
+        float fMin = 0.0f;
+        float fMax = 0.0f;
+        uint32_t sampleRate = 0;
+        uint16_t kLo = 0;               // only bins in [kLo, kHi] get a magnitude
+        uint16_t kHi = 0;
+        uint16_t k0[MAX_FFT_BINS];      // band = mean of mag[k0, k1)
+        uint16_t k1[MAX_FFT_BINS];
+    };
+    static BandPlan bandPlan;
+
+    // Working buffers
+    static Cpx work[M_MAX];
+    static Cpx spec[M_MAX];             // natural order
+
+    // Per-band result in the same units the float path reports
+    static FftBands bands;
+
+    //=====================================================================
+
+    inline int16_t q15(float v) {
+        const float s = v * 32768.0f;
+        if (s >= 32767.0f) return 32767;
+        if (s <= -32768.0f) return -32768;
+        return static_cast<int16_t>(lrintf(s));
+    }
+
+    // Base-4 digit reversal over `digits` digits
+    inline uint16_t rev4(uint16_t k, uint8_t digits) {
+        uint16_t r = 0;
+        for (uint8_t d = 0; d < digits; d++) {
+            r = (r << 2) | (k & 3);
+            k >>= 2;
+        }
+        return r;
+    }
+
+    // Twiddles and output order for an n-point real FFT; no-op if already built
+    void plan(uint16_t n) {
+        if (n == N) return;
+        N = n;
+        M = n / 2;
+        uint8_t log2M = 0;
+        while ((1u << log2M) < M) log2M++;
+        R = (log2M & 1) ? M / 2 : M;
+        const uint8_t digits = (log2M & ~1) / 2;
+
+        for (uint16_t k = 0; k < M; k++) {
+            const float aM = 6.28318531f * k / M;
+            const float aN = 6.28318531f * k / N;
+            twM[k] = { q15(fl::cosf(aM)), q15(-fl::sinf(aM)) };
+            twN[k] = { q15(fl::cosf(aN)), q15(-fl::sinf(aN)) };
+        }
+        if (R == M) {
+            for (uint16_t p = 0; p < M; p++) outIndex[p] = rev4(p, digits);
+        } else {
+            // After the radix-2 split, even outputs come from the first half and odd
+            // outputs from the second; each half is base-4 digit-reversed
+            for (uint16_t p = 0; p < R; p++) {
+                outIndex[p] = 2 * rev4(p, digits);
+                outIndex[R + p] = 2 * rev4(p, digits) + 1;
+            }
+        }
+        bandPlan.n = 0;
+    }
+
+    // Log-spaced band edges in bins; a band narrower than one bin takes its nearest bin
+    void planBands(uint8_t numBands, float fMin, float fMax, uint32_t sampleRate) {
+        BandPlan& bp = bandPlan;
+        if (bp.n == N && bp.numBands == numBands && bp.fMin == fMin && bp.fMax == fMax &&
+            bp.sampleRate == sampleRate) {
+            return;
+        }
+        bp.n = N;
+        bp.numBands = numBands;
+        bp.fMin = fMin;
+        bp.fMax = fMax;
+        bp.sampleRate = sampleRate;
+
+        const float binHz = static_cast<float>(sampleRate) / N;
+        bp.kLo = static_cast<uint16_t>(fl::clamp(fMin / binHz, 1.0f, (float)(M - 1)));
+        bp.kHi = static_cast<uint16_t>(fl::clamp(fMax / binHz + 1.0f, (float)bp.kLo, (float)(M - 1)));
+
+        const float ratio = fl::powf(fMax / fMin, 1.0f / numBands);
+        float fLo = fMin;
+        for (uint8_t bnd = 0; bnd < numBands; bnd++) {
+            const float fHi = fLo * ratio;
+            uint16_t k0 = static_cast<uint16_t>(fl::clamp(fLo / binHz + 0.5f, (float)bp.kLo, (float)bp.kHi));
+            uint16_t k1 = static_cast<uint16_t>(fl::clamp(fHi / binHz + 0.5f, (float)bp.kLo, (float)bp.kHi + 1.0f));
+            if (k1 <= k0) k1 = k0 + 1;
+            bp.k0[bnd] = k0;
+            bp.k1[bnd] = k1;
+            fLo = fHi;
+        }
+    }
+
+    //=====================================================================
+    // Kernel
+
+    inline Cpx cmul(int32_t re, int32_t im, Cpx w) {
+        return {
+            static_cast<int16_t>((re * w.re - im * w.im + 0x4000) >> 15),
+            static_cast<int16_t>((re * w.im + im * w.re + 0x4000) >> 15)
+        };
+    }
+
+    // In-place radix-4 DIF over R points starting at x; output base-4 digit-reversed.
+    // Inputs are scaled by 1/4 before each butterfly so nothing can overflow.
+    inline void radix4(Cpx* x) {
+        for (uint16_t L = R, stride = M / R; L >= 4; L >>= 2, stride <<= 2) {
+            const uint16_t q = L >> 2;
+            for (uint16_t g = 0; g < R; g += L) {
+                Cpx* p = x + g;
+                for (uint16_t j = 0; j < q; j++) {
+                    const int32_t ar = p[j].re >> 2,         ai = p[j].im >> 2;
+                    const int32_t br = p[j + q].re >> 2,     bi = p[j + q].im >> 2;
+                    const int32_t cr = p[j + 2 * q].re >> 2, ci = p[j + 2 * q].im >> 2;
+                    const int32_t dr = p[j + 3 * q].re >> 2, di = p[j + 3 * q].im >> 2;
+
+                    const int32_t t0r = ar + cr, t0i = ai + ci;
+                    const int32_t t1r = ar - cr, t1i = ai - ci;
+                    const int32_t t2r = br + dr, t2i = bi + di;
+                    const int32_t t3r = bi - di, t3i = dr - br;     // (b - d) * -i
+
+                    // W_L^m == W_M^(m * stride), stride = M / L
+                    p[j] = { static_cast<int16_t>(t0r + t2r), static_cast<int16_t>(t0i + t2i) };
+                    p[j + q]     = cmul(t1r + t3r, t1i + t3i, twM[j * stride]);
+                    p[j + 2 * q] = cmul(t0r - t2r, t0i - t2i, twM[2 * j * stride]);
+                    p[j + 3 * q] = cmul(t1r - t3r, t1i - t3i, twM[3 * j * stride]);
+                }
+            }
+        }
+    }
+
+    // M-point complex FFT of work[] into spec[] (natural order), scaled by 1/M
+    inline void fftComplex() {
+        if (R == M) {
+            radix4(work);
+        } else {
+            // Radix-2 DIF split: evens -> work[0..R), odds -> work[R..M), scaled by 1/2
+            for (uint16_t n = 0; n < R; n++) {
+                const int32_t ar = work[n].re >> 1,     ai = work[n].im >> 1;
+                const int32_t br = work[n + R].re >> 1, bi = work[n + R].im >> 1;
+                work[n] = { static_cast<int16_t>(ar + br), static_cast<int16_t>(ai + bi) };
+                work[n + R] = cmul(ar - br, ai - bi, twM[n]);
+            }
+            radix4(work);
+            radix4(work + R);
+        }
+        for (uint16_t p = 0; p < M; p++) {
+            spec[outIndex[p]] = work[p];
+        }
+    }
+
+    //=====================================================================
+
+    static int8_t blockShift = 0;       // input scale of the last transform()
+    static float mag[M_MAX];            // per-bin magnitudes from magnitudes()
+
+    // pcm: len windowed samples, oldest first (len = 512, 1024 or 2048) -> spec[]
+    void transform(const int16_t* pcm, uint16_t len) {
+        plan(len);
+
+        // Block floating point: bring the peak into [2^13, 2^14] so quiet input keeps
+        // its precision and no stage can overflow (|z| stays under 2^14·√2)
+        int32_t peak = 1;
+        for (uint16_t i = 0; i < N; i++) {
+            const int32_t a = pcm[i] < 0 ? -pcm[i] : pcm[i];
+            if (a > peak) peak = a;
+        }
+        int8_t shift = 0;
+        if (peak > 16384) {
+            shift = -1;
+        } else {
+            while (shift < 14 && (peak << (shift + 1)) <= 16384) shift++;
+        }
+        blockShift = shift;
+
+        // Pack even/odd samples as re/im of an M-point complex sequence
+        for (uint16_t n = 0; n < M; n++) {
+            const int32_t re = pcm[2 * n], im = pcm[2 * n + 1];
+            work[n] = shift >= 0
+                ? Cpx{ static_cast<int16_t>(re * (1 << shift)), static_cast<int16_t>(im * (1 << shift)) }
+                : Cpx{ static_cast<int16_t>(re >> 1), static_cast<int16_t>(im >> 1) };
+        }
+        fftComplex();
+    }
+
+    // Real-split pass over bins [kLo, kHi] of the last transform() into mag[], in int16
+    // amplitude units (full-scale sine ≈ 32768). Bins outside the range are untouched.
+    void magnitudes(uint16_t kLo, uint16_t kHi) {
+        if (kLo < 1) kLo = 1;
+        if (kHi > M - 1) kHi = M - 1;
+
+        // spec holds Z / M, so the split yields X / M = amplitude · 2^shift
+        const float toAmplitude = ldexpf(1.0f, -blockShift);
+        for (uint16_t k = kLo; k <= kHi; k++) {
+            const Cpx z = spec[k];
+            const Cpx zc = spec[M - k];
+            // Fe = (Z[k] + conj(Z[M-k])) / 2,  Fo = (Z[k] - conj(Z[M-k])) / 2i
+            const int32_t fer = (z.re + zc.re) >> 1, fei = (z.im - zc.im) >> 1;
+            const int32_t fOr = (z.im + zc.im) >> 1, fOi = (zc.re - z.re) >> 1;
+            const Cpx wfo = cmul(fOr, fOi, twN[k]);
+            const float xr = static_cast<float>(fer + wfo.re);
+            const float xi = static_cast<float>(fei + wfo.im);
+            mag[k] = fl::sqrtf(xr * xr + xi * xi) * toAmplitude;
+        }
+    }
+
+    // Returns per-band magnitudes with raw[] in int16 amplitude units and
+    // db[] = 20·log10(raw). Only bins inside [fMin, fMax] get a magnitude.
+    const FftBands* run(const int16_t* pcm, uint16_t len, uint8_t numBands, float fMin, float fMax, uint32_t sampleRate) {
+        transform(pcm, len);
+        planBands(numBands, fMin, fMax, sampleRate);
+        const BandPlan& bp = bandPlan;
+        magnitudes(bp.kLo, bp.kHi);
+
+        bands.count = numBands;
+        for (uint8_t bnd = 0; bnd < numBands; bnd++) {
+            float sum = 0.0f;
+            for (uint16_t k = bp.k0[bnd]; k < bp.k1[bnd]; k++) sum += mag[k];
+            const float raw = sum / (bp.k1[bnd] - bp.k0[bnd]);
+            bands.raw[bnd] = raw;
+            bands.db[bnd] = raw > 1.0f ? 20.0f * fl::log10f(raw) : 0.0f;
+        }
+        return &bands;
+    }
+
+} // namespace fftq15
+} // namespace myAudio
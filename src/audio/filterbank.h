@@ -0,0 +1,192 @@
+#pragma once
+
+// =====================================================
+// filterbank.h — Mel bands and chroma (optional stage).
+// Two sparse matrices over the linear FFT magnitudes of
+// the current window: NUM_MEL_BANDS triangular mel bands
+// and a 12-bin pitch-class (chroma) vector. Both are
+// built once per window length / sample rate and applied
+// with one sparse mat-vec each, so the cost per spectrum
+// is fixed by the non-zero count. Runs on the Q15
+// transform whichever backend feeds the buses.
+// Enabled with melChroma (cx27).
+// =====================================================
+
+#include "audioTypes.h"
+#include "fftQ15.h"
+
+namespace myAudio {
+
+    constexpr float MEL_MIN_FREQ = 40.f;
+    constexpr float MEL_MAX_FREQ = 8000.f;
+    constexpr float CHROMA_MIN_FREQ = 65.4f;    // C2
+    constexpr float CHROMA_MAX_FREQ = 5000.f;
+    constexpr float CHROMA_FLOOR = 8.0f;        // summed amplitude below this = silence (~-72 dBFS)
+
+    //=====================================================================
+    // SparseBank — CSR matrix, Q15 weights plus a float scale per row
+    //
+    // Row r sums mag[col[j]] · weight[j] for j in [rowStart[r], rowStart[r+1]).
+    // Each FFT bin feeds at most two rows (neighbouring triangles / pitch
+    // classes), so 2 · bins bounds the non-zeros.
+    //=====================================================================
+
+    struct SparseBank {
+        static constexpr uint8_t MAX_ROWS = NUM_MEL_BANDS;
+        static constexpr uint16_t MAX_NNZ = 2 * fftq15::M_MAX;
+
+        uint8_t rows = 0;
+        uint16_t nnz = 0;
+        uint16_t kLo = 0;                       // bins the rows read
+        uint16_t kHi = 0;
+        uint16_t rowStart[MAX_ROWS + 1];
+        float rowScale[MAX_ROWS];
+        uint16_t col[MAX_NNZ];
+        uint16_t weight[MAX_NNZ];               // Q15
+
+        void beginRow() { rowStart[rows] = nnz; }
+
+        void add(uint16_t k, float w) {
+            if (nnz >= MAX_NNZ || w <= 0.0f) return;
+            col[nnz] = k;
+            weight[nnz] = static_cast<uint16_t>(fl::clamp(w, 0.0f, 1.0f) * 32767.0f + 0.5f);
+            nnz++;
+        }
+
+        void endRow(float scale) {
+            rowScale[rows] = scale / 32767.0f;
+            rows++;
+            rowStart[rows] = nnz;
+        }
+
+        // y = W·x
+        void apply(const float* x, float* y) const {
+            for (uint8_t r = 0; r < rows; r++) {
+                float sum = 0.0f;
+                for (uint16_t j = rowStart[r]; j < rowStart[r + 1]; j++) {
+                    sum += x[col[j]] * weight[j];
+                }
+                y[r] = sum * rowScale[r];
+            }
+        }
+    };
+
+    //=====================================================================
+
+    struct MelChroma {
+        uint16_t n = 0;                         // window length the banks were built for
+        uint32_t sampleRate = 0;
+        SparseBank mel;
+        SparseBank chroma;
+        float melOut[NUM_MEL_BANDS] = {0};      // mean amplitude per band (int16 units)
+        float chromaOut[NUM_CHROMA] = {0};      // [0, 1], strongest class = 1
+    };
+
+    MelChroma melChromaState;
+
+    inline float hzToMel(float hz) { return 2595.0f * fl::log10f(1.0f + hz / 700.0f); }
+    inline float melToHz(float mel) { return 700.0f * (fl::powf(10.0f, mel / 2595.0f) - 1.0f); }
+
+    // Triangles evenly spaced in mel, each normalised to unit weight sum (band = mean
+    // amplitude). A triangle narrower than one bin takes its nearest bin.
+    inline void buildMelBank(SparseBank& bank, uint16_t n, uint32_t sampleRate) {
+        const float binHz = static_cast<float>(sampleRate) / n;
+        const uint16_t lastBin = n / 2 - 1;
+        const float fMax = FL_MIN(MEL_MAX_FREQ, 0.45f * sampleRate);
+        const float melLo = hzToMel(MEL_MIN_FREQ);
+        const float melStep = (hzToMel(fMax) - melLo) / (NUM_MEL_BANDS + 1);
+
+        bank.rows = 0;
+        bank.nnz = 0;
+        bank.kLo = lastBin;
+        bank.kHi = 1;
+        for (uint8_t band = 0; band < NUM_MEL_BANDS; band++) {
+            const float fL = melToHz(melLo + band * melStep);
+            const float fC = melToHz(melLo + (band + 1) * melStep);
+            const float fR = melToHz(melLo + (band + 2) * melStep);
+            const uint16_t k0 = static_cast<uint16_t>(fl::clamp(fL / binHz + 1.0f, 1.0f, (float)lastBin));
+            const uint16_t k1 = static_cast<uint16_t>(fl::clamp(fR / binHz, 1.0f, (float)lastBin));
+
+            bank.beginRow();
+            float sum = 0.0f;
+            for (uint16_t k = k0; k <= k1; k++) {
+                const float f = k * binHz;
+                const float w = (f <= fC) ? (f - fL) / (fC - fL) : (fR - f) / (fR - fC);
+                if (w <= 0.0f) continue;
+                bank.add(k, w);
+                sum += w;
+            }
+            if (sum <= 0.0f) {
+                const uint16_t k = static_cast<uint16_t>(fl::clamp(fC / binHz + 0.5f, 1.0f, (float)lastBin));
+                bank.add(k, 1.0f);
+                sum = 1.0f;
+            }
+            bank.endRow(1.0f / sum);
+            for (uint16_t j = bank.rowStart[band]; j < bank.nnz; j++) {
+                bank.kLo = FL_MIN(bank.kLo, bank.col[j]);
+                bank.kHi = FL_MAX(bank.kHi, bank.col[j]);
+            }
+        }
+    }
+
+    // Each bin's magnitude is split between the two pitch classes either side of
+    // its frequency, linearly in cents (C = 0 ... B = 11). Bins coarser than about
+    // two semitones (low frequencies, short windows) are left out.
+    inline void buildChromaBank(SparseBank& bank, uint16_t n, uint32_t sampleRate) {
+        const float binHz = static_cast<float>(sampleRate) / n;
+        const uint16_t lastBin = n / 2 - 1;
+        const float fMin = FL_MAX(CHROMA_MIN_FREQ, 8.0f * binHz);
+        const uint16_t k0 = static_cast<uint16_t>(fl::clamp(fMin / binHz + 0.5f, 1.0f, (float)lastBin));
+        const uint16_t k1 = static_cast<uint16_t>(fl::clamp(CHROMA_MAX_FREQ / binHz, (float)k0, (float)lastBin));
+
+        bank.rows = 0;
+        bank.nnz = 0;
+        bank.kLo = k0;
+        bank.kHi = k1;
+        for (uint8_t pc = 0; pc < NUM_CHROMA; pc++) {
+            bank.beginRow();
+            for (uint16_t k = k0; k <= k1; k++) {
+                const float midi = 69.0f + 12.0f * fl::log2f(k * binHz / 440.0f);
+                const float cls = fl::fmodf(midi, 12.0f);
+                const uint8_t lo = static_cast<uint8_t>(cls) % NUM_CHROMA;
+                const uint8_t hi = (lo + 1) % NUM_CHROMA;
+                const float frac = cls - static_cast<float>(static_cast<uint8_t>(cls));
+                if (lo == pc) bank.add(k, 1.0f - frac);
+                if (hi == pc) bank.add(k, frac);
+            }
+            bank.endRow(1.0f);
+        }
+    }
+
+    // Mel + chroma for the spectrum fftq15 last transformed (n samples at sampleRate)
+    inline void updateMelChroma(uint16_t n, uint32_t sampleRate) {
+        MelChroma& mc = melChromaState;
+        if (mc.n != n || mc.sampleRate != sampleRate) {
+            buildMelBank(mc.mel, n, sampleRate);
+            buildChromaBank(mc.chroma, n, sampleRate);
+            mc.n = n;
+            mc.sampleRate = sampleRate;
+        }
+
+        fftq15::magnitudes(FL_MIN(mc.mel.kLo, mc.chroma.kLo), FL_MAX(mc.mel.kHi, mc.chroma.kHi));
+        mc.mel.apply(fftq15::mag, mc.melOut);
+        mc.chroma.apply(fftq15::mag, mc.chromaOut);
+
+        float peak = 0.0f;
+        for (uint8_t i = 0; i < NUM_CHROMA; i++) peak = FL_MAX(peak, mc.chromaOut[i]);
+        const float inv = (peak > CHROMA_FLOOR) ? 1.0f / peak : 0.0f;
+        for (uint8_t i = 0; i < NUM_CHROMA; i++) mc.chromaOut[i] *= inv;
+    }
+
+    // Frame copy: mel on the fft_pre scale (linear, 0..1), chroma as computed
+    inline void publishMelChroma(AudioFrame& frame, bool fresh) {
+        frame.melChromaValid = fresh;
+        if (!fresh) return;
+        const MelChroma& mc = melChromaState;
+        for (uint8_t i = 0; i < NUM_MEL_BANDS; i++) {
+            frame.mel[i] = fl::clamp(mc.melOut[i] / 32768.0f, 0.0f, 1.0f);
+        }
+        for (uint8_t i = 0; i < NUM_CHROMA; i++) frame.chroma[i] = mc.chromaOut[i];
+    }
+
+} // namespace myAudio
@@ -0,0 +1,320 @@
+#pragma once
+
+// =====================================================
+// tempoTracker.h — Spectral-flux onsets, tempo and
+// beat phase
+//
+// Onset strength is the log-compressed spectral flux
+// between consecutive spectra (fft_pre). Its recent
+// history (~6 s) is autocorrelated every few hops; a
+// four-tap comb and a tempo prior centred on 120 BPM
+// pick the beat period. A beat-phase clock runs on
+// audio time between estimates and is pulled toward
+// the comb-filter phase of the onset history.
+//
+// Output (AudioFrame, via publishTempo()): bpm
+// (0 = not locked), beatPhase [0, 1) and nextBeatMs
+// in the frame.timestamp clock.
+// =====================================================
+
+#include "audioTypes.h"
+#include "fl/math/math.h"
+
+namespace myAudio {
+
+    //=====================================================================
+    // TempoTracker state
+    //=====================================================================
+
+    struct TempoTracker {
+
+        // --- Tuning ---
+        static constexpr uint16_t ODF_LEN        = 512;     // onset history, in ODF samples
+        static constexpr uint16_t ODF_SAMPLES    = 512;     // audio samples per ODF sample (~11.6 ms)
+        static constexpr float    FLUX_GAMMA     = 100.0f;  // log(1 + γ·mag) compression
+        static constexpr float    BPM_MIN        = 60.0f;
+        static constexpr float    BPM_MAX        = 200.0f;
+        static constexpr float    BPM_PRIOR      = 120.0f;  // centre of the log-Gaussian tempo prior
+        static constexpr float    PRIOR_OCTAVES  = 1.0f;    // its width (σ, in octaves)
+        static constexpr uint8_t  UPDATE_EVERY   = 16;      // ODF samples between estimates (~180 ms)
+        static constexpr float    LOCK_CONF      = 0.15f;   // confidence needed to report a tempo
+
+        // --- Onset detection function (ring, one sample per ODF period) ---
+        float odf[ODF_LEN] = {0};
+        uint16_t odfHead = 0;             // next write position
+        uint16_t odfFilled = 0;
+        float prevLog[MAX_FFT_BINS] = {0};
+        uint8_t prevCount = 0;            // band count prevLog was built with (0 = none)
+        float fluxAccum = 0.0f;           // flux summed over the hops of one ODF sample
+        uint16_t samplesAccum = 0;
+        uint32_t sampleRate = 0;          // rate the ring was built at
+        float odfMs = 0.0f;
+        uint8_t sinceEstimate = 0;
+
+        // --- Tempo (in ODF samples) ---
+        float period = 0.0f;              // 0 = no estimate yet
+        float candidate = 0.0f;           // competing estimate waiting for confirmation
+        uint8_t candidateHits = 0;
+
+        // --- Beat-phase clock (audio time) ---
+        float periodMs = 0.0f;
+        float sinceBeatMs = 0.0f;         // [0, periodMs)
+
+        // --- Outputs ---
+        float onset = 0.0f;               // latest per-band flux
+        float confidence = 0.0f;          // [0, 1] smoothed periodicity strength
+        float bpm = 0.0f;                 // 0 while unlocked
+    };
+
+    TempoTracker tempo;
+
+    //=====================================================================
+    // Helpers
+    //=====================================================================
+
+    inline float tempoOdfAt(const TempoTracker& tt, uint16_t age) {
+        // age 0 = newest sample
+        return tt.odf[(tt.odfHead + TempoTracker::ODF_LEN - 1 - age) % TempoTracker::ODF_LEN];
+    }
+
+    inline void resetTempoHistory(TempoTracker& tt) {
+        for (uint16_t i = 0; i < TempoTracker::ODF_LEN; i++) tt.odf[i] = 0.0f;
+        tt.odfHead = 0;
+        tt.odfFilled = 0;
+        tt.fluxAccum = 0.0f;
+        tt.samplesAccum = 0;
+        tt.sinceEstimate = 0;
+        tt.period = 0.0f;
+        tt.periodMs = 0.0f;
+        tt.candidateHits = 0;
+        tt.confidence = 0.0f;
+        tt.bpm = 0.0f;
+    }
+
+    //=====================================================================
+    // Onset strength: half-wave rectified log-magnitude flux, per band
+    //=====================================================================
+
+    inline float spectralFlux(TempoTracker& tt, const float* fftPre, uint8_t numBins) {
+        const bool comparable = (tt.prevCount == numBins);
+        float flux = 0.0f;
+        for (uint8_t i = 0; i < numBins; i++) {
+            const float l = fl::logf(1.0f + TempoTracker::FLUX_GAMMA * fftPre[i]);
+            if (comparable) flux += FL_MAX(0.0f, l - tt.prevLog[i]);
+            tt.prevLog[i] = l;
+        }
+        tt.prevCount = numBins;
+        return (comparable && numBins > 0) ? flux / numBins : 0.0f;
+    }
+
+    //=====================================================================
+    // Tempo: autocorrelation of the onset history, comb + prior
+    //
+    // score(l) = prior(l) · mean(acf(≈k·l)), k = 1..4, over the lags for
+    // BPM_MIN..BPM_MAX. A lag and its half (kick vs kick+off-beat hat) then
+    // score about the same and the prior settles the octave. The winning
+    // lag is refined on its longest comb tap, where a lag step is finest.
+    //=====================================================================
+
+    inline float estimatePeriod(const TempoTracker& tt, float odfMs, float& conf) {
+        conf = 0.0f;
+        const uint16_t n = tt.odfFilled;
+        const uint16_t lMin = static_cast<uint16_t>(FL_MAX(2.0f, 60000.0f / (TempoTracker::BPM_MAX * odfMs)));
+        const uint16_t lMax = static_cast<uint16_t>(60000.0f / (TempoTracker::BPM_MIN * odfMs) + 1.0f);
+        if (lMax <= lMin || 2 * lMax + 8 >= n) return 0.0f;
+        const uint16_t acfMax = FL_MIN(4 * lMax + 1, n - n / 4);
+
+        // Mean-removed history, oldest first
+        static float x[TempoTracker::ODF_LEN];
+        float mean = 0.0f;
+        for (uint16_t i = 0; i < n; i++) {
+            x[i] = tempoOdfAt(tt, n - 1 - i);
+            mean += x[i];
+        }
+        mean /= n;
+        float energy = 0.0f;
+        for (uint16_t i = 0; i < n; i++) {
+            x[i] -= mean;
+            energy += x[i] * x[i];
+        }
+        if (energy < 1e-9f) return 0.0f;
+
+        static float acf[TempoTracker::ODF_LEN];
+        for (uint16_t l = lMin - 1; l <= acfMax; l++) {
+            float s = 0.0f;
+            for (uint16_t i = l; i < n; i++) s += x[i] * x[i - l];
+            acf[l] = s / ((n - l) * (energy / n));       // unbiased, ~[-1, 1]
+        }
+
+        float best = -1e9f, sum = 0.0f;
+        uint16_t bestL = 0, count = 0;
+        for (uint16_t l = lMin; l <= lMax; l++) {
+            const float bpm = 60000.0f / (l * odfMs);
+            const float oct = fl::log2f(bpm / TempoTracker::BPM_PRIOR) / TempoTracker::PRIOR_OCTAVES;
+            const float prior = fl::expf(-0.5f * oct * oct);
+            float comb = 0.0f;
+            uint8_t taps = 0;
+            for (uint8_t k = 1; k <= 4 && k * l + k - 1 <= acfMax; k++, taps++) {
+                // k·l drifts from the true multiple by up to k/2 lags; take the best nearby
+                float tap = acf[k * l];
+                for (uint16_t j = k * l - (k - 1); j <= k * l + (k - 1); j++) tap = FL_MAX(tap, acf[j]);
+                comb += tap;
+            }
+            const float score = prior * comb / taps;
+            sum += score;
+            count++;
+            if (score > best) { best = score; bestL = l; }
+        }
+        if (best <= 0.0f) return 0.0f;
+
+        // Refine: local acf maximum near the longest tap, parabolic, divided back down.
+        // Same bound as the comb taps, so the ±(k-1) window stays within acf[..acfMax]
+        uint8_t k = 1;
+        while (k < 4 && (k + 1) * bestL + k <= acfMax) k++;
+        uint16_t peak = k * bestL;
+        for (uint16_t l = k * bestL - (k - 1); l <= k * bestL + (k - 1); l++) {
+            if (acf[l] > acf[peak]) peak = l;
+        }
+        float lag = static_cast<float>(peak);
+        if (peak > lMin && peak < acfMax) {
+            const float a = acf[peak - 1], c = acf[peak + 1];
+            const float d = a - 2.0f * acf[peak] + c;
+            if (d < 0.0f) lag += fl::clamp(0.5f * (a - c) / d, -0.5f, 0.5f);
+        }
+        lag /= k;
+
+        const float meanScore = sum / count;
+        conf = fl::clamp((best - meanScore) / (best + 1e-6f), 0.0f, 1.0f) * fl::clamp(acf[bestL] * 2.0f, 0.0f, 1.0f);
+        return lag;
+    }
+
+    //=====================================================================
+    // Phase: comb over the onset history at the current period
+    //
+    // Returns the age (ODF samples) of the most recent beat: the offset φ
+    // that maximises Σ odf[φ + k·period], k = 0..3.
+    //=====================================================================
+
+    inline float estimateBeatAge(const TempoTracker& tt) {
+        const uint16_t p = static_cast<uint16_t>(tt.period + 0.5f);
+        if (p < 2 || tt.odfFilled < 4 * p + 2) return -1.0f;
+        constexpr float weight[4] = { 1.0f, 0.8f, 0.6f, 0.4f };
+        float best = -1.0f;
+        uint16_t bestPhi = 0;
+        for (uint16_t phi = 0; phi < p; phi++) {
+            float s = 0.0f;
+            for (uint8_t k = 0; k < 4; k++) {
+                s += weight[k] * tempoOdfAt(tt, static_cast<uint16_t>(phi + k * tt.period + 0.5f));
+            }
+            if (s > best) { best = s; bestPhi = phi; }
+        }
+        return static_cast<float>(bestPhi);
+    }
+
+    inline void updateTempoEstimate(TempoTracker& tt) {
+        const float odfMs = tt.odfMs;
+        float conf = 0.0f;
+        const float est = estimatePeriod(tt, odfMs, conf);
+
+        tt.confidence += 0.3f * (conf - tt.confidence);
+        if (est <= 0.0f) return;
+
+        // Follow small drift right away; a different tempo has to win three estimates in a row
+        if (tt.period <= 0.0f) {
+            tt.period = est;
+        } else if (fl::fabsf(est - tt.period) < 0.06f * tt.period) {
+            tt.period += 0.3f * (est - tt.period);
+            tt.candidateHits = 0;
+        } else if (tt.candidateHits > 0 && fl::fabsf(est - tt.candidate) < 0.06f * tt.candidate) {
+            tt.candidate += 0.5f * (est - tt.candidate);
+            if (++tt.candidateHits >= 3) {
+                tt.period = tt.candidate;
+                tt.candidateHits = 0;
+            }
+        } else {
+            tt.candidate = est;
+            tt.candidateHits = 1;
+        }
+
+        const bool firstLock = (tt.periodMs <= 0.0f);
+        tt.periodMs = tt.period * odfMs;
+        if (tt.sinceBeatMs >= tt.periodMs) tt.sinceBeatMs = fl::fmodf(tt.sinceBeatMs, tt.periodMs);
+
+        // Pull the phase clock toward the onset comb (circular error, half a beat max)
+        const float age = estimateBeatAge(tt);
+        if (age >= 0.0f) {
+            const float measured = age * odfMs;
+            float err = measured - tt.sinceBeatMs;
+            if (err > 0.5f * tt.periodMs) err -= tt.periodMs;
+            if (err < -0.5f * tt.periodMs) err += tt.periodMs;
+            tt.sinceBeatMs += (firstLock ? 1.0f : 0.35f) * err;
+            if (tt.sinceBeatMs < 0.0f) tt.sinceBeatMs += tt.periodMs;
+            if (tt.sinceBeatMs >= tt.periodMs) tt.sinceBeatMs -= tt.periodMs;
+        }
+    }
+
+    //=====================================================================
+    // updateTempo — call once per FFT hop with that hop's spectrum
+    //
+    // Time is counted in samples, so hops of any size (or a short last hop
+    // in a block) land on the same ODF grid. fftPre may be null (no
+    // spectrum yet); the phase clock still advances.
+    //=====================================================================
+
+    inline void updateTempo(const float* fftPre, uint8_t numBins, uint16_t hopSamples, uint32_t sampleRate) {
+        TempoTracker& tt = tempo;
+        if (hopSamples == 0 || sampleRate == 0) return;
+
+        if (sampleRate != tt.sampleRate) {
+            resetTempoHistory(tt);
+            tt.sampleRate = sampleRate;
+            tt.odfMs = TempoTracker::ODF_SAMPLES * 1000.0f / sampleRate;
+        }
+
+        // Phase clock
+        if (tt.periodMs > 0.0f) {
+            tt.sinceBeatMs += hopSamples * 1000.0f / sampleRate;
+            while (tt.sinceBeatMs >= tt.periodMs) tt.sinceBeatMs -= tt.periodMs;
+        }
+
+        // Onset strength, summed up to one ODF sample
+        tt.onset = fftPre ? spectralFlux(tt, fftPre, numBins) : 0.0f;
+        tt.fluxAccum += tt.onset;
+        tt.samplesAccum += hopSamples;
+        if (tt.samplesAccum < TempoTracker::ODF_SAMPLES) return;
+
+        tt.odf[tt.odfHead] = tt.fluxAccum;
+        tt.odfHead = (tt.odfHead + 1) % TempoTracker::ODF_LEN;
+        if (tt.odfFilled < TempoTracker::ODF_LEN) tt.odfFilled++;
+        tt.fluxAccum = 0.0f;
+        tt.samplesAccum -= TempoTracker::ODF_SAMPLES;
+
+        if (++tt.sinceEstimate >= TempoTracker::UPDATE_EVERY) {
+            tt.sinceEstimate = 0;
+            updateTempoEstimate(tt);
+        }
+
+        tt.bpm = (tt.periodMs > 0.0f && tt.confidence >= TempoTracker::LOCK_CONF)
+            ? 60000.0f / tt.periodMs : 0.0f;
+    }
+
+    //=====================================================================
+    // publishTempo — copy the tracker state into a frame, with the phase
+    // referenced to frame.timestamp (the end of the newest hop)
+    //=====================================================================
+
+    inline void publishTempo(AudioFrame& frame) {
+        const TempoTracker& tt = tempo;
+        frame.onset = tt.onset;
+        frame.tempoConfidence = tt.confidence;
+        frame.bpm = tt.bpm;
+        if (tt.bpm > 0.0f) {
+            frame.beatPhase = tt.sinceBeatMs / tt.periodMs;
+            frame.nextBeatMs = frame.timestamp + static_cast<uint32_t>(tt.periodMs - tt.sinceBeatMs + 0.5f);
+        } else {
+            frame.beatPhase = 0.0f;
+            frame.nextBeatMs = 0;
+        }
+    }
+
+} // namespace myAudio
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <NimBLEDevice.h>
+#include <atomic>
 #include "parameterSchema.h"
+#include "commandQueue.h"
 
 #if __has_include("hosted_ble_bridge.h")
     #include "hosted_ble_bridge.h"
@@ -11,6 +13,7 @@
 
 #include <FS.h>
 #include "LittleFS.h"
+#include "presetStore.h"
 #define FORMAT_LITTLEFS_IF_FAILED true 
 
 ArduinoJson::JsonDocument sendDoc;
@@ -25,6 +28,7 @@ NimBLECharacteristic* pButtonCharacteristic = NULL;
 NimBLECharacteristic* pCheckboxCharacteristic = NULL;
 NimBLECharacteristic* pNumberCharacteristic = NULL;
 NimBLECharacteristic* pStringCharacteristic = NULL;
+NimBLECharacteristic* pParamCharacteristic = NULL;
 NimBLEAdvertising* pAdvertising = NULL;
 
 bool deviceConnected = false;
@@ -35,6 +39,7 @@ bool wasConnected = false;
 #define CHECKBOX_CHARACTERISTIC_UUID   "19b10002-e8f2-537e-4f6c-d104768a1214"
 #define NUMBER_CHARACTERISTIC_UUID     "19b10003-e8f2-537e-4f6c-d104768a1214"
 #define STRING_CHARACTERISTIC_UUID     "19b10004-e8f2-537e-4f6c-d104768a1214"
+#define PARAM_CHARACTERISTIC_UUID      "19b10005-e8f2-537e-4f6c-d104768a1214"
 
 
 //*******************************************************************************
@@ -123,91 +128,158 @@ void sendReceiptString(String receivedID, String receivedValue) {
    }
 }
 
-//***********************************************************************
+//*******************************************************************************
+// BINARY PARAMETERS ************************************************************
+//
+// Packed alternative to the Number characteristic: no JSON parse or serialize.
+// Writes and notifies share one layout, a header plus 6-byte records:
+//
+//   header:  version u8 | PARAM_ID_COUNT u8 | BUS_PARAM_COUNT u8
+//   record:  paramId u8 | busId i8 | value f32 (little-endian, as on the ESP32)
+//
+// busId < 0 addresses a ParamId; busId 0..2 addresses BUS_PARAM_IDS[paramId] on
+// that bus. Receipts are not sent per write: changed params are marked dirty and
+// flushParamNotifications() (called from loop()) sends at most one packed
+// notify per PARAM_NOTIFY_INTERVAL_MS with the latest value of each.
+
+constexpr uint8_t BINARY_PARAM_VERSION = 2;
+constexpr uint8_t BINARY_PARAM_HEADER = 3;
+constexpr uint8_t BINARY_PARAM_RECORD = 6;
+constexpr uint8_t BINARY_PARAM_MAX_RECORDS = 32;   // keeps a notify under ~200 bytes
+constexpr uint32_t PARAM_NOTIFY_INTERVAL_MS = 40;
+
+void writeBinaryParamHeader(uint8_t* out) {
+   out[0] = BINARY_PARAM_VERSION;
+   out[1] = PARAM_ID_COUNT;
+   out[2] = BUS_PARAM_COUNT;
+}
 
+// Marked while commands are applied, drained by flushParamNotifications()
+std::atomic<uint32_t> paramDirty[(PARAM_ID_COUNT + 31) / 32];
+std::atomic<uint32_t> busParamDirty{0};       // bit = busId * BUS_PARAM_COUNT + paramId
+float paramReceiptValue[PARAM_ID_COUNT];
+float busParamReceiptValue[3][BUS_PARAM_COUNT];
+std::atomic<bool> binaryParamClient{false};   // connected UI speaks the binary protocol
 
+void markParamDirty(uint8_t id, float value) {
+   paramReceiptValue[id] = value;
+   paramDirty[id >> 5].fetch_or(1u << (id & 31));
+}
 
-// Auto-generated helper functions using X-macros
-void captureCurrentParameters(ArduinoJson::JsonObject& params) {
-    #define X(type, parameter, def) params[#parameter] = c##parameter;
-    PARAMETER_TABLE
-    #undef X
+void markBusParamDirty(uint8_t busId, uint8_t id, float value) {
+   busParamReceiptValue[busId][id] = value;
+   busParamDirty.fetch_or(1u << (busId * BUS_PARAM_COUNT + id));
 }
 
-void applyCurrentParameters(const ArduinoJson::JsonObjectConst& params) {
-    #define X(type, parameter, def) \
-        if (!params[#parameter].isNull()) { \
-            auto newValue = params[#parameter].as<type>(); \
-            if (c##parameter != newValue) { \
-                c##parameter = newValue; \
-                sendReceiptNumber("in" #parameter, c##parameter); \
-            } \
-        }
-    PARAMETER_TABLE
-    #undef X
+// Receipt for a change the device made itself (preset load): coalesced for a
+// binary client, a JSON Number receipt otherwise
+void noteParamChanged(uint8_t id) {
+   if (binaryParamClient) {
+      markParamDirty(id, getParamValue(id));
+   } else {
+      sendReceiptNumber(String("in") + PARAM_INFO[id].name, getParamValue(id));
+   }
+}
+
+void flushParamNotifications() {
+
+   static uint32_t lastNotifyMs = 0;
+   if (!deviceConnected || pParamCharacteristic == nullptr) { return; }
+   if (millis() - lastNotifyMs < PARAM_NOTIFY_INTERVAL_MS) { return; }
+
+   static uint8_t packet[BINARY_PARAM_HEADER + BINARY_PARAM_MAX_RECORDS * BINARY_PARAM_RECORD];
+   size_t len = BINARY_PARAM_HEADER;
+   uint8_t count = 0;
+
+   auto put = [&](uint8_t id, int8_t busId, float value) {
+      uint8_t* out = packet + len;
+      out[0] = id;
+      out[1] = (uint8_t)busId;
+      memcpy(out + 2, &value, sizeof(value));
+      len += BINARY_PARAM_RECORD;
+      count++;
+   };
+
+   // Whatever doesn't fit stays dirty for the next interval
+   for (uint8_t w = 0; w < (PARAM_ID_COUNT + 31) / 32 && count < BINARY_PARAM_MAX_RECORDS; w++) {
+      uint32_t bits = paramDirty[w].load();
+      while (bits != 0 && count < BINARY_PARAM_MAX_RECORDS) {
+         const uint8_t bit = __builtin_ctz(bits);
+         bits &= bits - 1;
+         paramDirty[w].fetch_and(~(1u << bit));
+         const uint8_t id = w * 32 + bit;
+         put(id, -1, paramReceiptValue[id]);
+      }
+   }
+   uint32_t busBits = busParamDirty.load();
+   while (busBits != 0 && count < BINARY_PARAM_MAX_RECORDS) {
+      const uint8_t bit = __builtin_ctz(busBits);
+      busBits &= busBits - 1;
+      busParamDirty.fetch_and(~(1u << bit));
+      const uint8_t busId = bit / BUS_PARAM_COUNT;
+      const uint8_t id = bit % BUS_PARAM_COUNT;
+      put(id, (int8_t)busId, busParamReceiptValue[busId][id]);
+   }
+
+   if (count == 0) { return; }
+
+   writeBinaryParamHeader(packet);
+   pParamCharacteristic->setValue(packet, len);
+   pParamCharacteristic->notify();
+   lastNotifyMs = millis();
 }
 
-// Preset file persistence functions with JSON structure
+//***********************************************************************
+
+
+
+// Presets live in presetStore's RAM slots (see presetStore.h); save writes
+// the slot through to flash, load never touches flash or JSON.
+bool applyParam(uint8_t id, float value);
+void sendBusState();
+
 bool savePreset(int presetNumber) {
-    String filename = "/preset_";
-    filename += presetNumber;
-    filename += ".json";
-    
-    ArduinoJson::JsonDocument preset;
-    preset["programNum"] = PROGRAM;
-    if (MODE_COUNTS[PROGRAM] > 0) { 
-      preset["modeNum"] = MODE;
-    }    
-    ArduinoJson::JsonObject params = preset["parameters"].to<ArduinoJson::JsonObject>();
-    captureCurrentParameters(params);
-    
-    File file = LittleFS.open(filename, "w");
-    if (!file) {
+    if (!presetStore::save(presetNumber)) {
         Serial.print("Failed to save preset: ");
-        Serial.println(filename);
+        Serial.println(presetNumber);
         return false;
     }
-    
-    serializeJson(preset, file);
-    file.close();
-    
     Serial.print("Preset saved: ");
-    Serial.println(filename);
+    Serial.println(presetNumber);
     return true;
 }
 
 bool loadPreset(int presetNumber) {
-    String filename = "/preset_";
-    filename += presetNumber;
-    filename += ".json";
-    
-    File file = LittleFS.open(filename, "r");
-    if (!file) {
-        Serial.print("Failed to load preset: ");
-        Serial.println(filename);
+    if (!presetStore::validNumber(presetNumber) || !presetStore::slots[presetNumber - 1].valid) {
+        Serial.print("No preset stored: ");
+        Serial.println(presetNumber);
         return false;
     }
-    
-    ArduinoJson::JsonDocument preset;
-    ArduinoJson::DeserializationError error = deserializeJson(preset, file);
-    file.close();
-    
-    if (preset["programNum"].isNull() || preset["parameters"].isNull()) {
-        Serial.print("Invalid preset format: ");
-        Serial.println(filename);
-        return false;
+    const presetStore::Preset& preset = presetStore::slots[presetNumber - 1];
+
+    PROGRAM = preset.program;
+    if (preset.mode != presetStore::NO_MODE) {
+      MODE = preset.mode;
     }
 
-    PROGRAM = (uint8_t)preset["programNum"];
-    if (!preset["modeNum"].isNull()) {
-      MODE = (uint8_t)preset["modeNum"];
+    // Only changed values are applied and receipted
+    for (uint8_t id = 0; id < presetStore::STORED_PARAM_COUNT; id++) {
+        if (preset.hasParam(id) && getParamValue(id) != preset.params[id]) {
+            applyParam(id, preset.params[id]);
+            noteParamChanged(id);
+        }
+    }
+
+    if (setBusParam != nullptr && preset.busMask != 0) {
+        for (uint8_t busId = 0; busId < 3; busId++) {
+            for (uint8_t p = 0; p < BUS_PARAM_COUNT; p++) {
+                if (!preset.hasBusParam(busId, p)) continue;
+                setBusParam(busId, BUS_PARAM_IDS[p], preset.bus[busId][p]);
+                if (binaryParamClient) markBusParamDirty(busId, p, preset.bus[busId][p]);
+            }
+        }
+        if (!binaryParamClient) sendBusState();
     }
-    //pauseAnimation = true;
-    applyCurrentParameters(preset["parameters"]);
-    //pauseAnimation = false;
-    
-    Serial.print("Preset loaded: ");
-    Serial.println(filename);
     return true;
 }
 
@@ -263,22 +335,18 @@ void sendVisualizerState() {
            char paramName[32];
            ::strcpy(paramName, (char*)pgm_read_ptr(&visualizerParams->params[i]));
 
-           bool paramFound = false;
-           // Use X-macro to match parameter names and add values
-           // Handle case-insensitive comparison for parameter names
-           #define X(type, parameter, def) \
-               if (strcasecmp(paramName, #parameter) == 0) { \
-                   params[paramName] = c##parameter; \
-                   if (debug) { \
-                       Serial.print("Added parameter "); \
-                       Serial.print(paramName); \
-                       Serial.print(": "); \
-                       Serial.println(c##parameter); \
-                   } \
-                   paramFound = true; \
+           // Case-insensitive lookup in the parameter index
+           const uint8_t id = findParam(paramName);
+           const bool paramFound = id < PARAM_ID_COUNT && PARAM_INFO[id].ptr != nullptr;
+           if (paramFound) {
+               putParamJson(params, paramName, id);
+               if (debug) {
+                   Serial.print("Added parameter ");
+                   Serial.print(paramName);
+                   Serial.print(": ");
+                   Serial.println(getParamValue(id));
                }
-           PARAMETER_TABLE
-           #undef X
+           }
 
            if (!paramFound) {
                Serial.print("Warning: Parameter not found in X-macro table: ");
@@ -322,17 +390,15 @@ void sendAudioState() {
    ArduinoJson::JsonDocument stateDoc;
    ArduinoJson::JsonObject params = stateDoc["parameters"].to<ArduinoJson::JsonObject>();
 
-   // Iterate AUDIO_PARAMS and match against PARAMETER_TABLE via X-macro
+   // Iterate AUDIO_PARAMS and look each one up in the parameter index
    for (uint8_t i = 0; i < AUDIO_PARAM_COUNT; i++) {
        char paramName[32];
        ::strcpy(paramName, (char*)pgm_read_ptr(&AUDIO_PARAMS[i]));
 
-       #define X(type, parameter, def) \
-           if (strcasecmp(paramName, #parameter) == 0) { \
-               params[paramName] = c##parameter; \
-           }
-       PARAMETER_TABLE
-       #undef X
+       const uint8_t id = findParam(paramName);
+       if (id < PARAM_ID_COUNT && PARAM_INFO[id].ptr != nullptr) {
+           putParamJson(params, paramName, id);
+       }
    }
 
    String stateJson;
@@ -346,16 +412,12 @@ void sendBusState() {
 
    // Bus params live on Bus structs (outside X-macro system).
    // Send one message per bus to stay within BLE MTU limits.
-   const char* busParamNames[] = {"threshold", "minBeatInterval", "expDecayFactor",
-                                   "rampAttack", "rampDecay", "peakBase"};
-   const uint8_t busParamCount = 6;
-
    for (uint8_t busId = 0; busId < 3; busId++) {
        ArduinoJson::JsonDocument stateDoc;
        stateDoc["bus"] = busId;
        ArduinoJson::JsonObject params = stateDoc["parameters"].to<ArduinoJson::JsonObject>();
-       for (uint8_t p = 0; p < busParamCount; p++) {
-           params[busParamNames[p]] = getBusParam(busId, busParamNames[p]);
+       for (uint8_t p = 0; p < BUS_PARAM_COUNT; p++) {
+           params[BUS_PARAM_NAMES[p]] = getBusParam(busId, BUS_PARAM_NAMES[p]);
        }
 
        String stateJson;
@@ -427,46 +489,63 @@ void processButton(uint8_t receivedValue) {
 
 //*****************************************************************************
 
-void processNumber(String receivedID, float receivedValue, int8_t busId = -1) {
-
-   sendReceiptNumber(receivedID, receivedValue);
+// Sets one parameter by numeric ID (ParamId), with the side effects the
+// Number characteristic has always applied. Unknown IDs are ignored.
+bool applyParam(uint8_t id, float value) {
 
-   if (busId >= 0 && busId < 3 && setBusParam != nullptr) {
-      setBusParam((uint8_t)busId, receivedID, receivedValue);
-      return;
+   if (id >= PARAM_ID_COUNT || !isfinite(value)) {
+      return false;
    }
-  
-   if (receivedID == "inBright") {
-      cBright = receivedValue;
-      BRIGHTNESS = cBright;
-      FastLED.setBrightness(BRIGHTNESS);
-   };
+   setParamValue(id, value);
 
+   switch (id) {
+      case PID_Bright:
+         BRIGHTNESS = cBright;   // picked up by outputStage::render()
+         break;
 
-   if (receivedID == "inPalNum") {
-      uint8_t newPalNum = receivedValue;
-      gTargetPalette = gGradientPalettes[ newPalNum ];
-      if(debug) {
-         Serial.print("newPalNum: ");
-         Serial.println(newPalNum);
-      }
-   };
-  
-   //-------------------------------------------------------
-   // Auto-generated custom parameter handling using X-macros
-   bool handledParameter = false;
-   #define X(type, parameter, def) \
-       if (receivedID == "in" #parameter) { c##parameter = receivedValue; handledParameter = true; }
-   PARAMETER_TABLE
-   #undef X
-
-   if (receivedID == "inLightBias" || receivedID == "inDramaScale") {
-      updateScene = true;
+      case PID_PalNum:
+         // cPalNum is already saturated to 0..255; any client can send any value
+         if (cPalNum < gGradientPaletteCount) {
+            gTargetPalette = gGradientPalettes[ cPalNum ];
+         }
+         if(debug) {
+            Serial.print("newPalNum: ");
+            Serial.println(cPalNum);
+         }
+         break;
+
+      case PID_LightBias:
+      case PID_DramaScale:
+         updateScene = true;
+         break;
+
+      default:
+         break;
    }
+   return true;
+}
+
+// Native-typed JSON value for a ParamId (ints stay ints, bools stay bools)
+void putParamJson(ArduinoJson::JsonObject& params, const char* key, uint8_t id) {
+   const ParamInfo& p = PARAM_INFO[id];
+   switch (p.type) {
+      case PARAM_BOOL:  params[key] = *static_cast<const bool*>(p.ptr); break;
+      case PARAM_U8:    params[key] = *static_cast<const uint8_t*>(p.ptr); break;
+      case PARAM_U16:   params[key] = *static_cast<const uint16_t*>(p.ptr); break;
+      case PARAM_FLOAT: params[key] = *static_cast<const float*>(p.ptr); break;
+   }
+}
+
+void processNumber(String receivedID, float receivedValue, int8_t busId = -1) {
+
+   sendReceiptNumber(receivedID, receivedValue);
 
-   if (handledParameter) {
+   if (busId >= 0 && busId < 3 && setBusParam != nullptr) {
+      if (isfinite(receivedValue)) setBusParam((uint8_t)busId, receivedID, receivedValue);
       return;
    }
+
+   applyParam(findParamByBleId(receivedID.c_str()), receivedValue);
 }
 
 void processCheckbox(String receivedID, bool receivedValue ) {
@@ -494,6 +573,11 @@ void processCheckbox(String receivedID, bool receivedValue ) {
    if (receivedID == "cx21") {cAngleFreezeX = receivedValue;};
    if (receivedID == "cx22") {cAngleFreezeY = receivedValue;};
    if (receivedID == "cx23") {cAngleFreezeZ = receivedValue;};
+
+   if (receivedID == "cx24") {intNoise = receivedValue;};
+   if (receivedID == "cx25") {fixedFft = receivedValue;};
+   if (receivedID == "cx26") {avPredict = receivedValue;};
+   if (receivedID == "cx27") {melChroma = receivedValue;};
    
    if (receivedID == "cxLayer1") {Layer1 = receivedValue;};
    if (receivedID == "cxLayer2") {Layer2 = receivedValue;};
@@ -512,126 +596,199 @@ void processString(String receivedID, String receivedValue ) {
 }
 
 //*******************************************************************************
-// CALLBACKS ********************************************************************
-
-   class MyServerCallbacks: public NimBLEServerCallbacks {
-   void onConnect(NimBLEServer* pServer, NimBLEConnInfo& connInfo) override {
-      deviceConnected = true;
-      wasConnected = true;
-      Serial.println("[ble] connected");
-      if (debug) {Serial.println("Device Connected");}
-   };
-
-   void onDisconnect(NimBLEServer* pServer, NimBLEConnInfo& connInfo, int reason) override {
-      deviceConnected = false;
-      wasConnected = true;
-      Serial.printf("[ble] disconnected reason=%d\n", reason);
+// BINARY PARAMETER WRITES ******************************************************
+
+// Applies every record in one write (a batch), then queues their receipts for
+// flushParamNotifications(). A header that doesn't match this build is answered
+// at once with the bare header and nothing is applied, so the UI falls back to
+// JSON. A header with no records announces a binary-capable client.
+void processBinaryParams(const uint8_t* data, size_t len) {
+
+   const bool compatible = len >= BINARY_PARAM_HEADER &&
+                           data[0] == BINARY_PARAM_VERSION &&
+                           data[1] == PARAM_ID_COUNT &&
+                           data[2] == BUS_PARAM_COUNT;
+
+   if (!compatible) {
+      uint8_t header[BINARY_PARAM_HEADER];
+      writeBinaryParamHeader(header);
+      pParamCharacteristic->setValue(header, BINARY_PARAM_HEADER);
+      pParamCharacteristic->notify();
+      if (debug) { Serial.println("Binary params: header mismatch"); }
+      return;
    }
-   };
-
-   class ButtonCharacteristicCallbacks : public NimBLECharacteristicCallbacks {
-      void onWrite(NimBLECharacteristic *pCharacteristic, NimBLEConnInfo& connInfo) override {
-
-         NimBLEAttValue value = pCharacteristic->getValue();
-         if (value.size() > 0) {
-
-            uint8_t receivedValue = value[0];
-
-            if (debug) {
-               Serial.print("Button value received: ");
-               Serial.println(receivedValue);
-            }
-
-            processButton(receivedValue);
 
+   binaryParamClient = true;
+
+   const size_t records = FL_MIN((len - BINARY_PARAM_HEADER) / BINARY_PARAM_RECORD,
+                                 (size_t)BINARY_PARAM_MAX_RECORDS);
+   for (size_t r = 0; r < records; r++) {
+      const uint8_t* rec = data + BINARY_PARAM_HEADER + r * BINARY_PARAM_RECORD;
+      const uint8_t id = rec[0];
+      const int8_t busId = (int8_t)rec[1];
+      float value;
+      memcpy(&value, rec + 2, sizeof(value));
+      if (!isfinite(value)) continue;    // raw f32 from the client
+
+      if (busId >= 0) {
+         if (busId < 3 && id < BUS_PARAM_COUNT && setBusParam != nullptr) {
+            setBusParam((uint8_t)busId, BUS_PARAM_IDS[id], value);
+            markBusParamDirty((uint8_t)busId, id, value);
          }
+      } else if (applyParam(id, value)) {
+         markParamDirty(id, getParamValue(id, value));
       }
-   };
-
-   class CheckboxCharacteristicCallbacks : public NimBLECharacteristicCallbacks {
-      void onWrite(NimBLECharacteristic *pCharacteristic, NimBLEConnInfo& connInfo) override {
-
-         String receivedBuffer = String(pCharacteristic->getValue().c_str());
-
-         if (receivedBuffer.length() > 0) {
-
-            if (debug) {
-               Serial.print("Received buffer: ");
-               Serial.println(receivedBuffer);
-            }
+   }
 
-            ArduinoJson::deserializeJson(receivedJSON, receivedBuffer);
-            String receivedID = receivedJSON["id"] ;
-            bool receivedValue = receivedJSON["val"];
+   if (debug) {
+      Serial.print("Binary params: ");
+      Serial.print(records);
+      Serial.println(" records");
+   }
+}
 
-            if (debug) {
-               Serial.print(receivedID);
-               Serial.print(": ");
-               Serial.println(receivedValue);
-            }
+//*******************************************************************************
+// COMMAND QUEUE ****************************************************************
+//
+// Characteristic writes arrive on the NimBLE host task while loop() may be
+// mid-frame on the other core. The callbacks only copy each write into
+// bleCommands; drainBleCommands() decodes and applies them at the top of loop(),
+// so PROGRAM/MODE/params/layers never change under a running effect, and JSON
+// parsing and debug printing stay off the BLE task. One write is one command,
+// so a binary batch is still applied as a unit.
+
+enum BleSource : uint8_t { BLE_BUTTON, BLE_CHECKBOX, BLE_NUMBER, BLE_STRING, BLE_PARAM };
+
+constexpr uint16_t BLE_COMMAND_MAX_BYTES = 200;   // largest write: a 32-record binary batch (195)
+
+struct BleCommand {
+   BleSource source;
+   uint16_t len;
+   uint8_t data[BLE_COMMAND_MAX_BYTES];
+};
+
+SpscQueue<BleCommand, 16> bleCommands;
+std::atomic<uint16_t> droppedBleCommands{0};
+
+void enqueueBleCommand(BleSource source, const uint8_t* data, size_t len) {
+   if (len == 0) { return; }
+   BleCommand* cmd = (len <= BLE_COMMAND_MAX_BYTES) ? bleCommands.beginPush() : nullptr;
+   if (cmd == nullptr) {
+      droppedBleCommands++;
+      return;
+   }
+   cmd->source = source;
+   cmd->len = (uint16_t)len;
+   memcpy(cmd->data, data, len);
+   bleCommands.endPush();
+}
 
-            processCheckbox(receivedID, receivedValue);
+void applyBleCommand(const BleCommand& cmd) {
 
-         }
+   if (cmd.source == BLE_BUTTON) {
+      if (debug) {
+         Serial.print("Button value received: ");
+         Serial.println(cmd.data[0]);
       }
-   };
-
-   class NumberCharacteristicCallbacks : public NimBLECharacteristicCallbacks {
-      void onWrite(NimBLECharacteristic *pCharacteristic, NimBLEConnInfo& connInfo) override {
+      processButton(cmd.data[0]);
+      return;
+   }
 
-         String receivedBuffer = String(pCharacteristic->getValue().c_str());
+   if (cmd.source == BLE_PARAM) {
+      processBinaryParams(cmd.data, cmd.len);
+      return;
+   }
 
-         if (receivedBuffer.length() > 0) {
+   if (debug) {
+      Serial.print("Received buffer: ");
+      Serial.write(cmd.data, cmd.len);
+      Serial.println();
+   }
 
-            if (debug) {
-               Serial.print("Received buffer: ");
-               Serial.println(receivedBuffer);
-            }
+   ArduinoJson::deserializeJson(receivedJSON, (const char*)cmd.data, cmd.len);
+   String receivedID = receivedJSON["id"];
 
-            ArduinoJson::deserializeJson(receivedJSON, receivedBuffer);
-            String receivedID = receivedJSON["id"] ;
-            float receivedValue = receivedJSON["val"];
-            int8_t receivedBus = -1;
-            if (!receivedJSON["bus"].isNull()) {
-               receivedBus = receivedJSON["bus"].as<int8_t>();
-            }
+   if (cmd.source == BLE_CHECKBOX) {
+      bool receivedValue = receivedJSON["val"];
+      if (debug) {
+         Serial.print(receivedID);
+         Serial.print(": ");
+         Serial.println(receivedValue);
+      }
+      processCheckbox(receivedID, receivedValue);
+   }
 
-            if (debug) {
-               Serial.print(receivedID);
-               Serial.print(": ");
-               Serial.println(receivedValue);
-            }
+   if (cmd.source == BLE_NUMBER) {
+      float receivedValue = receivedJSON["val"];
+      int8_t receivedBus = -1;
+      if (!receivedJSON["bus"].isNull()) {
+         receivedBus = receivedJSON["bus"].as<int8_t>();
+      }
+      if (debug) {
+         Serial.print(receivedID);
+         Serial.print(": ");
+         Serial.println(receivedValue);
+      }
+      processNumber(receivedID, receivedValue, receivedBus);
+   }
 
-            processNumber(receivedID, receivedValue, receivedBus);
-         }
+   if (cmd.source == BLE_STRING) {
+      String receivedValue = receivedJSON["val"];
+      if (debug) {
+         Serial.print(receivedID);
+         Serial.print(": ");
+         Serial.println(receivedValue);
       }
-   };
+      processString(receivedID, receivedValue);
+   }
+}
 
-   class StringCharacteristicCallbacks : public NimBLECharacteristicCallbacks {
-      void onWrite(NimBLECharacteristic *pCharacteristic, NimBLEConnInfo& connInfo) override {
+// Called at the top of loop(): applies everything received since the last frame
+void drainBleCommands() {
+   while (BleCommand* cmd = bleCommands.front()) {
+      applyBleCommand(*cmd);
+      bleCommands.pop();
+   }
 
-         String receivedBuffer = String(pCharacteristic->getValue().c_str());
+   const uint16_t dropped = droppedBleCommands.exchange(0);
+   if (dropped > 0) {
+      Serial.print("[ble] dropped commands: ");
+      Serial.println(dropped);
+   }
+}
 
-         if (receivedBuffer.length() > 0) {
+//*******************************************************************************
+// CALLBACKS ********************************************************************
 
-            if (debug) {
-               Serial.print("Received buffer: ");
-               Serial.println(receivedBuffer);
-            }
+   class MyServerCallbacks: public NimBLEServerCallbacks {
+   void onConnect(NimBLEServer* pServer, NimBLEConnInfo& connInfo) override {
+      deviceConnected = true;
+      wasConnected = true;
+      binaryParamClient = false;   // until this client announces itself
+      Serial.println("[ble] connected");
+      if (debug) {Serial.println("Device Connected");}
+   };
 
-            ArduinoJson::deserializeJson(receivedJSON, receivedBuffer);
-            String receivedID = receivedJSON["id"] ;
-            String receivedValue = receivedJSON["val"];
+   void onDisconnect(NimBLEServer* pServer, NimBLEConnInfo& connInfo, int reason) override {
+      deviceConnected = false;
+      wasConnected = true;
+      binaryParamClient = false;
+      Serial.printf("[ble] disconnected reason=%d\n", reason);
+   }
+   };
 
-            if (debug) {
-               Serial.print(receivedID);
-               Serial.print(": ");
-               Serial.println(receivedValue);
-            }
+   // Every characteristic write is copied into the command queue as-is
+   class QueuedCharacteristicCallbacks : public NimBLECharacteristicCallbacks {
+   public:
+      explicit QueuedCharacteristicCallbacks(BleSource source) : source(source) {}
 
-            processString(receivedID, receivedValue);
-         }
+      void onWrite(NimBLECharacteristic *pCharacteristic, NimBLEConnInfo& connInfo) override {
+         NimBLEAttValue value = pCharacteristic->getValue();
+         enqueueBleCommand(source, value.data(), value.size());
       }
+
+   private:
+      BleSource source;
    };
 
 
@@ -660,7 +817,7 @@ void bleSetup() {
                         NIMBLE_PROPERTY::READ |
                         NIMBLE_PROPERTY::NOTIFY
                      );
-      pButtonCharacteristic->setCallbacks(new ButtonCharacteristicCallbacks());
+      pButtonCharacteristic->setCallbacks(new QueuedCharacteristicCallbacks(BLE_BUTTON));
 
       pCheckboxCharacteristic = pService->createCharacteristic(
                         CHECKBOX_CHARACTERISTIC_UUID,
@@ -668,7 +825,7 @@ void bleSetup() {
                         NIMBLE_PROPERTY::READ |
                         NIMBLE_PROPERTY::NOTIFY
                      );
-      pCheckboxCharacteristic->setCallbacks(new CheckboxCharacteristicCallbacks());
+      pCheckboxCharacteristic->setCallbacks(new QueuedCharacteristicCallbacks(BLE_CHECKBOX));
 
       pNumberCharacteristic = pService->createCharacteristic(
                         NUMBER_CHARACTERISTIC_UUID,
@@ -676,7 +833,7 @@ void bleSetup() {
                         NIMBLE_PROPERTY::READ |
                         NIMBLE_PROPERTY::NOTIFY
                      );
-      pNumberCharacteristic->setCallbacks(new NumberCharacteristicCallbacks());
+      pNumberCharacteristic->setCallbacks(new QueuedCharacteristicCallbacks(BLE_NUMBER));
 
       pStringCharacteristic = pService->createCharacteristic(
                         STRING_CHARACTERISTIC_UUID,
@@ -684,7 +841,19 @@ void bleSetup() {
                         NIMBLE_PROPERTY::READ |
                         NIMBLE_PROPERTY::NOTIFY
                      );
-      pStringCharacteristic->setCallbacks(new StringCharacteristicCallbacks());
+      pStringCharacteristic->setCallbacks(new QueuedCharacteristicCallbacks(BLE_STRING));
+
+      pParamCharacteristic = pService->createCharacteristic(
+                        PARAM_CHARACTERISTIC_UUID,
+                        NIMBLE_PROPERTY::WRITE |
+                        NIMBLE_PROPERTY::WRITE_NR |
+                        NIMBLE_PROPERTY::READ |
+                        NIMBLE_PROPERTY::NOTIFY
+                     );
+      pParamCharacteristic->setCallbacks(new QueuedCharacteristicCallbacks(BLE_PARAM));
+      uint8_t paramHeader[BINARY_PARAM_HEADER];
+      writeBinaryParamHeader(paramHeader);
+      pParamCharacteristic->setValue(paramHeader, BINARY_PARAM_HEADER);   // read by the UI on connect
 
 
       //**********************************************************
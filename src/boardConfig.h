@@ -9,7 +9,29 @@
 //#define BIG_BOARD
 #undef BIG_BOARD
 
-#if defined(CONFIG_IDF_TARGET_ESP32S3)
+#if defined(AURORA_HOST)
+
+    // --- Host (native) build: no LED driver; geometry chosen per env in
+    //     platformio_native.ini so each shipped panel can be rendered ---
+    #if defined(HOST_MATRIX_22x22)
+        #include "reference/matrixMap_22x22.h"
+        #define HEIGHT 22
+        #define WIDTH 22
+    #elif defined(HOST_MATRIX_32x48)
+        #include "reference/matrixMap_32x48_3pin.h"
+        #define HEIGHT 32
+        #define WIDTH 48
+    #else
+        #include "reference/matrixMap_48x64_12pin.h"
+        #define HEIGHT 48
+        #define WIDTH  64
+    #endif
+    #define PIN0 0
+    #define NUM_STRIPS 1
+    #define NUM_LEDS_PER_STRIP (WIDTH * HEIGHT)
+    #define LED_DRIVER "STUB"
+
+#elif defined(CONFIG_IDF_TARGET_ESP32S3)
     
     #ifdef BIG_BOARD
         
@@ -0,0 +1,46 @@
+#pragma once
+
+// =====================================================
+// commandQueue.h — Lock-free single-producer /
+// single-consumer ring. Slots are claimed and filled in
+// place, so a producer on one core (NimBLE host task)
+// never blocks, allocates or copies twice, and the
+// consumer (loop()) sees each slot only once it has
+// been fully written.
+// =====================================================
+
+#include <atomic>
+#include <stdint.h>
+
+template <typename T, uint8_t N>
+class SpscQueue {
+    static_assert(N > 0 && N <= 128 && (N & (N - 1)) == 0, "N must be a power of two <= 128");
+
+public:
+    // Producer: next free slot, or nullptr when full. Publish it with endPush().
+    T* beginPush() {
+        const uint8_t h = head.load(std::memory_order_relaxed);
+        if ((uint8_t)(h - tail.load(std::memory_order_acquire)) == N) return nullptr;
+        return &slots[h & (N - 1)];
+    }
+
+    void endPush() {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer: oldest published slot, or nullptr when empty. Release it with pop().
+    T* front() {
+        const uint8_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) return nullptr;
+        return &slots[t & (N - 1)];
+    }
+
+    void pop() {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+private:
+    T slots[N];
+    std::atomic<uint8_t> head{0};   // producer only writes
+    std::atomic<uint8_t> tail{0};   // consumer only writes
+};
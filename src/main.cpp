@@ -75,6 +75,8 @@ bool audioLatencyDiagnostics = false;
 const uint16_t MIN_DIMENSION = FL_MIN(WIDTH, HEIGHT);
 const uint16_t MAX_DIMENSION = FL_MAX(WIDTH, HEIGHT);
 
+// Row-major canvas (index y * WIDTH + x) that every program draws into;
+// outputStage maps it to wire order once per frame
 fl::CRGB leds[NUM_LEDS];
 uint16_t ledNum = 0;
 
@@ -96,6 +98,8 @@ uint8_t BRIGHTNESS;
 uint8_t defaultMapping = 0;
 bool mappingOverride = false;
 
+#include "outputStage.h"
+#include "showPipeline.h"
 #include "audio/audioInput.h"
 #include "audio/audioProcessing.h"
 #include "bleControl.h"
@@ -138,20 +142,12 @@ enum Mapping {
 };
 
 // General (non-FL::XYMap) mapping 
+// Programs address the row-major canvas; the cMapping table is applied once per
+// frame by outputStage::render() (see runProgram())
 	
 	uint16_t myXY(uint8_t x, uint8_t y) {
 			if (x >= WIDTH || y >= HEIGHT) return 0;
-			uint16_t i = ( y * WIDTH ) + x;
-			switch(cMapping){
-				case 0:	 ledNum = progTopDown[i]; break;
-				case 1:	 ledNum = progBottomUp[i]; break;
-				case 2:	 ledNum = serpTopDown[i]; break;
-				case 3:	 ledNum = serpBottomUp[i]; break;
-				//case 4:	 ledNum = vProgTopDown[i]; break;
-				//case 5:	 ledNum = vSerpTopDown[i]; break;
-			}
-			return ledNum;
-	
+			return ( y * WIDTH ) + x;
 	}
 
 	// Used only for FL::XYMap purposes
@@ -176,7 +172,9 @@ enum Mapping {
 
 	//XYMap myXYmap = XYMap::constructWithUserFunction(WIDTH, HEIGHT, myXYFunction);
 	
-	XYMap myXYmap = XYMap::constructWithLookUpTable(WIDTH, HEIGHT, progBottomUp);
+	// Was constructWithLookUpTable(WIDTH, HEIGHT, progBottomUp); the progBottomUp
+	// permutation now happens in outputStage for the programs that use myXYmap
+	XYMap myXYmap = XYMap::constructRectangularGrid(WIDTH, HEIGHT);
 	XYMap xyRect = XYMap::constructRectangularGrid(WIDTH, HEIGHT);
 
 
@@ -202,63 +200,53 @@ void setup() {
 	//MODE = savedMode;
 	
 	FastLED.setExclusiveDriver(LED_DRIVER);
-	
-	FastLED.addLeds<WS2812B, PIN0, GRB>(leds, 0, NUM_LEDS_PER_STRIP)
-		.setCorrection(TypicalLEDStrip);
+
+	// Controllers send outputStage::frame as-is: it's already in wire order (GRB)
+	// with correction, gamma and brightness applied
+	FastLED.addLeds<WS2812B, PIN0, RGB>(outputStage::frame, 0, NUM_LEDS_PER_STRIP);
 
 		#ifdef PIN1
-		FastLED.addLeds<WS2812B, PIN1, GRB>(leds, NUM_LEDS_PER_STRIP, NUM_LEDS_PER_STRIP)
-			.setCorrection(TypicalLEDStrip);
+		FastLED.addLeds<WS2812B, PIN1, RGB>(outputStage::frame, NUM_LEDS_PER_STRIP, NUM_LEDS_PER_STRIP);
 	#endif
 
 	#ifdef PIN2
-		FastLED.addLeds<WS2812B, PIN2, GRB>(leds, NUM_LEDS_PER_STRIP * 2, NUM_LEDS_PER_STRIP)
-			.setCorrection(TypicalLEDStrip);
+		FastLED.addLeds<WS2812B, PIN2, RGB>(outputStage::frame, NUM_LEDS_PER_STRIP * 2, NUM_LEDS_PER_STRIP);
 	#endif
 
 	#ifdef PIN3
-		FastLED.addLeds<WS2812B, PIN3, GRB>(leds, NUM_LEDS_PER_STRIP * 3, NUM_LEDS_PER_STRIP)
-			.setCorrection(TypicalLEDStrip);
+		FastLED.addLeds<WS2812B, PIN3, RGB>(outputStage::frame, NUM_LEDS_PER_STRIP * 3, NUM_LEDS_PER_STRIP);
 	#endif
 
 	#ifdef PIN4
-		FastLED.addLeds<WS2812B, PIN4, GRB>(leds, NUM_LEDS_PER_STRIP * 4, NUM_LEDS_PER_STRIP)
-			.setCorrection(TypicalLEDStrip);
+		FastLED.addLeds<WS2812B, PIN4, RGB>(outputStage::frame, NUM_LEDS_PER_STRIP * 4, NUM_LEDS_PER_STRIP);
 	#endif
 
 	#ifdef PIN5
-		FastLED.addLeds<WS2812B, PIN5, GRB>(leds, NUM_LEDS_PER_STRIP * 5, NUM_LEDS_PER_STRIP)
-			.setCorrection(TypicalLEDStrip);
+		FastLED.addLeds<WS2812B, PIN5, RGB>(outputStage::frame, NUM_LEDS_PER_STRIP * 5, NUM_LEDS_PER_STRIP);
 	#endif
 	
 	#ifdef PIN6
-		FastLED.addLeds<WS2812B, PIN6, GRB>(leds, NUM_LEDS_PER_STRIP * 6, NUM_LEDS_PER_STRIP)
-			.setCorrection(TypicalLEDStrip);
+		FastLED.addLeds<WS2812B, PIN6, RGB>(outputStage::frame, NUM_LEDS_PER_STRIP * 6, NUM_LEDS_PER_STRIP);
 	#endif
 
 	#ifdef PIN7
-		FastLED.addLeds<WS2812B, PIN7, GRB>(leds, NUM_LEDS_PER_STRIP * 7, NUM_LEDS_PER_STRIP)
-			.setCorrection(TypicalLEDStrip);
+		FastLED.addLeds<WS2812B, PIN7, RGB>(outputStage::frame, NUM_LEDS_PER_STRIP * 7, NUM_LEDS_PER_STRIP);
 	#endif
 
 	#ifdef PIN8
-		FastLED.addLeds<WS2812B, PIN8, GRB>(leds, NUM_LEDS_PER_STRIP * 8, NUM_LEDS_PER_STRIP)
-			.setCorrection(TypicalLEDStrip);
+		FastLED.addLeds<WS2812B, PIN8, RGB>(outputStage::frame, NUM_LEDS_PER_STRIP * 8, NUM_LEDS_PER_STRIP);
 	#endif
 
 	#ifdef PIN9
-		FastLED.addLeds<WS2812B, PIN9, GRB>(leds, NUM_LEDS_PER_STRIP * 9, NUM_LEDS_PER_STRIP)
-			.setCorrection(TypicalLEDStrip);
+		FastLED.addLeds<WS2812B, PIN9, RGB>(outputStage::frame, NUM_LEDS_PER_STRIP * 9, NUM_LEDS_PER_STRIP);
 	#endif
 
 	#ifdef PIN10
-		FastLED.addLeds<WS2812B, PIN10, GRB>(leds, NUM_LEDS_PER_STRIP * 10, NUM_LEDS_PER_STRIP)
-			.setCorrection(TypicalLEDStrip);
+		FastLED.addLeds<WS2812B, PIN10, RGB>(outputStage::frame, NUM_LEDS_PER_STRIP * 10, NUM_LEDS_PER_STRIP);
 	#endif
 
 	#ifdef PIN11
-		FastLED.addLeds<WS2812B, PIN11, GRB>(leds, NUM_LEDS_PER_STRIP * 11, NUM_LEDS_PER_STRIP)
-			.setCorrection(TypicalLEDStrip);
+		FastLED.addLeds<WS2812B, PIN11, RGB>(outputStage::frame, NUM_LEDS_PER_STRIP * 11, NUM_LEDS_PER_STRIP);
 	#endif
 
 	#ifdef CONFIG_IDF_TARGET_ESP32S3
@@ -267,7 +255,8 @@ void setup() {
 		#endif
 	#endif
 	
-	FastLED.setBrightness(BRIGHTNESS);
+	FastLED.setBrightness(255);
+	FastLED.setDither(DISABLE_DITHER);	// outputStage::render() dithers before brightness is baked in
 
 	FastLED.clear();
 	FastLED.show();
@@ -279,10 +268,12 @@ void setup() {
 		//return;
 	} else {
 		Serial.println("LittleFS mounted successfully.");
+		presetStore::loadAll();
 	}
 
 	myAudio::initAudioInput();
 	myAudio::initAudioProcessing();
+	myAudio::audioTask::begin();
 
 }
 
@@ -328,12 +319,155 @@ void updateSettings_mode(uint8_t newMode){
 	FASTLED_DBG("Mode setting updated");
 }
 
+//*****************************************************************************************
+// Program dispatch: one frame of the active PROGRAM/MODE into leds[].
+// Shared by loop() and the host runner (host/hostRunner.hpp).
+
+// Clears every per-program *Instance flag so the next runProgram() re-inits
+void resetProgramInstances() {
+	rainbow::rainbowInstance = false;
+	waves::wavesInstance = false;
+	bubble::bubbleInstance = false;
+	dots::dotsInstance = false;
+	fxWave2d::fxWave2dInstance = false;
+	radii::radiiInstance = false;
+	animartrix::animartrixInstance = false;
+	test::testInstance = false;
+	synaptide::synaptideInstance = false;
+	cube::cubeInstance = false;
+	horizons::horizonsInstance = false;
+	audioTest::audioTestInstance = false;
+}
+
+void runProgram() {
+
+	mappingOverride ? cMapping = cOverrideMapping : cMapping = defaultMapping;
+
+	// Program-change detector: when PROGRAM changes, clear all per-program
+	// *Instance flags so the target program re-inits cleanly on re-entry.
+	// Without this, the one-way `if (!xInstance) initX()` guards skip init
+	// after the first visit, and state from the previous session persists.
+	static uint8_t lastProgram = 0xFF;
+	if (PROGRAM != lastProgram) {
+		resetProgramInstances();
+		lastProgram = PROGRAM;
+	}
+
+	switch(PROGRAM){
+
+		case 0:
+			defaultMapping = Mapping::TopDownProgressive;
+			if (!rainbow::rainbowInstance) {
+				rainbow::initRainbow(myXY);
+			}
+			rainbow::runRainbow();
+			break; 
+
+		case 1:
+			// 1D; mapping not needed
+			defaultMapping = Mapping::TopDownProgressive;
+			if (!waves::wavesInstance) {
+				waves::initWaves();
+			}
+			waves::runWaves(); 
+			break;
+
+		case 2:  
+			defaultMapping = Mapping::TopDownSerpentine;
+			if (!bubble::bubbleInstance) {
+				bubble::initBubble(myXY);
+			}
+			bubble::runBubble();
+			break;  
+
+		case 3:
+			defaultMapping = Mapping::TopDownProgressive;
+			if (!dots::dotsInstance) {
+				dots::initDots(myXY);
+			}
+			dots::runDots();
+			break;  
+		
+		case 4:
+			if (!fxWave2d::fxWave2dInstance) {
+				fxWave2d::initFxWave2d(myXYmap, xyRect);
+			}
+			fxWave2d::runFxWave2d();
+			break;
+
+		case 5:    
+			defaultMapping = Mapping::TopDownProgressive;
+			if (!radii::radiiInstance) {
+				radii::initRadii(myXY);
+			}
+			radii::runRadii();
+			break;
+		
+		case 6:  
+			if (!animartrix::animartrixInstance) {
+				animartrix::initAnimartrix(myXYmap);
+			}
+			animartrix::runAnimartrix();
+			break;
+
+		case 7:    
+			defaultMapping = Mapping::TopDownProgressive;
+			if (!test::testInstance) {
+				test::initTest(myXY);
+			}
+			test::runTest();
+			break;
+
+		case 8:    
+			defaultMapping = Mapping::TopDownProgressive;
+			if (!synaptide::synaptideInstance) {
+				synaptide::initSynaptide(myXY);
+			}
+			synaptide::runSynaptide();
+			break;
+
+		case 9:    
+			defaultMapping = Mapping::TopDownProgressive;
+			if (!cube::cubeInstance) {
+				cube::initCube(myXY);
+			}
+			cube::runCube();
+			break;
+
+		case 10:    
+			defaultMapping = Mapping::TopDownProgressive;
+			if (!horizons::horizonsInstance) {
+				horizons::initHorizons(myXY);
+			}
+			horizons::runHorizons();
+			break;
+		
+		case 11:
+			defaultMapping = Mapping::TopDownProgressive;
+			if (!audioTest::audioTestInstance) {
+				audioTest::initAudioTest(myXY);
+			}
+			audioTest::runAudioTest();
+			break;
+	}
+
+	// Wire-order table for this frame's canvas. fxWave2d and animartrix always
+	// drew through myXYmap (progBottomUp); everything else follows cMapping.
+	outputStage::activeMap = (PROGRAM == 4 || PROGRAM == 6)
+		? progBottomUp
+		: outputStage::mapFor(cMapping);
+
+} // runProgram()
+
 //*****************************************************************************************
 
 void loop() {
 
 	PROFILE_FRAME_BEGIN();
 
+	// BLE writes queued since the last frame (bleControl.h), applied between frames
+	drainBleCommands();
+
 	// Hybrid audio pipeline: capture + FFT/bus processing happens inside
 	// myAudio::updateAudioFrame() (called by each audio-enabled program).
 	// Avoid draining the I2S queue here, otherwise the program-stage update
@@ -373,137 +507,21 @@ void loop() {
 	}
 	
 	if (!displayOn){
-		FastLED.clear();
+		fill_solid(leds, NUM_LEDS, CRGB::Black);
 	}
 	
 	else {
-
-		mappingOverride ? cMapping = cOverrideMapping : cMapping = defaultMapping;
-
-		// Program-change detector: when PROGRAM changes, clear all per-program
-		// *Instance flags so the target program re-inits cleanly on re-entry.
-		// Without this, the one-way `if (!xInstance) initX()` guards skip init
-		// after the first visit, and state from the previous session persists.
-		static uint8_t lastProgram = 0xFF;
-		if (PROGRAM != lastProgram) {
-			rainbow::rainbowInstance = false;
-			waves::wavesInstance = false;
-			bubble::bubbleInstance = false;
-			dots::dotsInstance = false;
-			fxWave2d::fxWave2dInstance = false;
-			radii::radiiInstance = false;
-			animartrix::animartrixInstance = false;
-			test::testInstance = false;
-			synaptide::synaptideInstance = false;
-			cube::cubeInstance = false;
-			horizons::horizonsInstance = false;
-			audioTest::audioTestInstance = false;
-			lastProgram = PROGRAM;
-		}
-
-		switch(PROGRAM){
-
-			case 0:
-				defaultMapping = Mapping::TopDownProgressive;
-				if (!rainbow::rainbowInstance) {
-					rainbow::initRainbow(myXY);
-				}
-				rainbow::runRainbow();
-				break; 
-
-			case 1:
-				// 1D; mapping not needed
-				defaultMapping = Mapping::TopDownProgressive;
-				if (!waves::wavesInstance) {
-					waves::initWaves();
-				}
-				waves::runWaves(); 
-				break;
-
-			case 2:  
-				defaultMapping = Mapping::TopDownSerpentine;
-				if (!bubble::bubbleInstance) {
-					bubble::initBubble(myXY);
-				}
-				bubble::runBubble();
-				break;  
-
-			case 3:
-				defaultMapping = Mapping::TopDownProgressive;
-				if (!dots::dotsInstance) {
-					dots::initDots(myXY);
-				}
-				dots::runDots();
-				break;  
-			
-			case 4:
-				if (!fxWave2d::fxWave2dInstance) {
-					fxWave2d::initFxWave2d(myXYmap, xyRect);
-				}
-				fxWave2d::runFxWave2d();
-				break;
-
-			case 5:    
-				defaultMapping = Mapping::TopDownProgressive;
-				if (!radii::radiiInstance) {
-					radii::initRadii(myXY);
-				}
-				radii::runRadii();
-				break;
-			
-			case 6:  
-				if (!animartrix::animartrixInstance) {
-					animartrix::initAnimartrix(myXYmap);
-				}
-				animartrix::runAnimartrix();
-				break;
-
-			case 7:    
-				defaultMapping = Mapping::TopDownProgressive;
-				if (!test::testInstance) {
-					test::initTest(myXY);
-				}
-				test::runTest();
-				break;
-
-			case 8:    
-				defaultMapping = Mapping::TopDownProgressive;
-				if (!synaptide::synaptideInstance) {
-					synaptide::initSynaptide(myXY);
-				}
-				synaptide::runSynaptide();
-				break;
-
-			case 9:    
-				defaultMapping = Mapping::TopDownProgressive;
-				if (!cube::cubeInstance) {
-					cube::initCube(myXY);
-				}
-				cube::runCube();
-				break;
-
-			case 10:    
-				defaultMapping = Mapping::TopDownProgressive;
-				if (!horizons::horizonsInstance) {
-					horizons::initHorizons(myXY);
-				}
-				horizons::runHorizons();
-				break;
-			
-			case 11:
-				defaultMapping = Mapping::TopDownProgressive;
-				if (!audioTest::audioTestInstance) {
-					audioTest::initAudioTest(myXY);
-				}
-				audioTest::runAudioTest();
-				break;
-		}
+		runProgram();
 	}
 
-	PROFILE_START("led_show");
-	FastLED.show();
-	PROFILE_END();
+	// Hands the canvas to the show task; the next frame renders while this one
+	// is transmitted (showPipeline::enabled = false shows inline as before)
+	showPipeline::present(leds, BRIGHTNESS);
+	myAudio::notePresented(showPipeline::latencyMs);
 	
+	// at most one packed parameter receipt per PARAM_NOTIFY_INTERVAL_MS
+	flushParamNotifications();
+
 	// upon BLE disconnect
 	if (!deviceConnected && wasConnected) {
 		if (debug) {Serial.println("Device disconnected.");}
@@ -516,3 +534,9 @@ void loop() {
 	PROFILE_FRAME_END();
 
 } // loop()
+
+//*****************************************************************************************
+
+#ifdef AURORA_HOST
+	#include "hostRunner.hpp"
+#endif
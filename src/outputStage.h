@@ -0,0 +1,108 @@
+#pragma once
+
+//========================================================================================
+// outputStage — the one pass between the row-major canvas and the LED driver
+//
+// Programs draw into leds[] as a row-major canvas (index y * WIDTH + x) and never look
+// at the physical wiring. Just before FastLED.show(), render() runs a single pass
+// over the canvas that does all of the following at once:
+//   - permutes each pixel into wire order through the active mapping table
+//   - applies gamma, color correction and global brightness (one LUT per channel)
+//   - temporal dithering in place of FastLED's (see below)
+//   - swizzles to the strip's byte order (WS2812B: GRB)
+//
+// FastLED's controllers are registered on outputStage::frame as RGB with brightness
+// 255 and no correction, so they send these bytes as they are; its own dithering has
+// nothing left to do there and is disabled. The LUT therefore keeps 8 fractional
+// bits, and render() adds a per-frame offset before dropping them. Over 8 frames a
+// channel averages to 1/8 step, which matters at low brightness (cBright 35 leaves
+// only ~35 output levels). Odd pixels use the opposite phase so the frame as a whole
+// doesn't pulse. The power limiter still works on frame[].
+//========================================================================================
+
+#include <stdint.h>
+#include <math.h>
+
+extern const uint16_t progTopDown[NUM_LEDS] PROGMEM;
+extern const uint16_t progBottomUp[NUM_LEDS] PROGMEM;
+extern const uint16_t serpTopDown[NUM_LEDS] PROGMEM;
+extern const uint16_t serpBottomUp[NUM_LEDS] PROGMEM;
+
+namespace outputStage {
+
+    fl::CRGB frame[NUM_LEDS];                       // wire order, handed to FastLED
+
+    const uint16_t* activeMap = progTopDown;        // canvas index -> LED index
+    float gamma = 1.0f;                             // 1.0 = linear (no curve)
+    const fl::CRGB correction = fl::CRGB(TypicalLEDStrip);
+
+    // Output byte positions for r, g, b (WS2812B wants G, R, B on the wire)
+    constexpr uint8_t WIRE_R = 1;
+    constexpr uint8_t WIRE_G = 0;
+    constexpr uint8_t WIRE_B = 2;
+
+    bool dither = true;                             // false = truncate, as with DISABLE_DITHER
+
+    uint16_t lut[3][256];                           // output level in 8.8 fixed point
+    uint8_t lutBrightness = 0;
+    float lutGamma = -1.0f;                         // forces a build on first render()
+
+    // Same table choice myXY() used to make per pixel
+    const uint16_t* mapFor(uint8_t mapping) {
+        switch (mapping) {
+            case 1:  return progBottomUp;
+            case 2:  return serpTopDown;
+            case 3:  return serpBottomUp;
+            default: return progTopDown;
+        }
+    }
+
+    // Per-channel scale the way FastLED's computeAdjustment() derives it
+    // (correction x uncorrected temperature x brightness), then scale on top of gamma
+    void buildLut(uint8_t brightness) {
+        for (uint8_t c = 0; c < 3; c++) {
+            const uint8_t adj = (uint8_t)(((uint32_t)correction.raw[c] + 1) * 256 * brightness / 0x10000);
+            for (int v = 0; v < 256; v++) {
+                uint8_t g = (uint8_t)v;
+                if (gamma != 1.0f) {
+                    g = (uint8_t)lrintf(255.0f * powf(v / 255.0f, gamma));
+                }
+                lut[c][v] = (uint16_t)(g * adj);     // <= 255 * 255, so + 255 still fits
+            }
+        }
+        lutBrightness = brightness;
+        lutGamma = gamma;
+    }
+
+    //=====================================================================
+
+    // Bit-reversed 3-bit counter, in 1/256 steps: spreads the rounding error
+    // evenly over 8 frames, like FastLED's own dither sequence
+    constexpr uint8_t DITHER_STEPS[8] = { 0, 128, 64, 192, 32, 160, 96, 224 };
+    uint8_t ditherFrame = 0;
+
+    void render(const fl::CRGB* canvas, uint8_t brightness) {
+        if (brightness != lutBrightness || gamma != lutGamma) {
+            buildLut(brightness);
+        }
+        uint16_t offset[2] = { 0, 0 };                  // even, odd canvas pixels
+        if (dither) {
+            ditherFrame = (ditherFrame + 1) & 7;
+            offset[0] = DITHER_STEPS[ditherFrame];
+            offset[1] = DITHER_STEPS[ditherFrame ^ 4];  // +128 out of phase
+        }
+        const uint16_t* map = activeMap;
+        const uint16_t* lr = lut[0];
+        const uint16_t* lg = lut[1];
+        const uint16_t* lb = lut[2];
+        for (uint16_t i = 0; i < NUM_LEDS; i++) {
+            const fl::CRGB& src = canvas[i];
+            const uint16_t d = offset[i & 1];
+            uint8_t* dst = frame[map[i]].raw;
+            dst[WIRE_R] = (uint8_t)((lr[src.r] + d) >> 8);
+            dst[WIRE_G] = (uint8_t)((lg[src.g] + d) >> 8);
+            dst[WIRE_B] = (uint8_t)((lb[src.b] + d) >> 8);
+        }
+    }
+
+} // namespace outputStage
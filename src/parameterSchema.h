@@ -3,6 +3,7 @@
 #include "FastLED.h"
 #include <ArduinoJson.h>
 #include <string>
+#include <math.h>
 
 bool displayOn = true;
 
@@ -249,10 +250,11 @@ extern uint8_t MODE;
       "avLevelerTarget", "autoFloorAlpha", "autoFloorMin", "autoFloorMax",
       "noiseGateOpen", "noiseGateClose",
       "threshold", "minBeatInterval",
-      "rampAttack", "rampDecay", "peakBase", "expDecayFactor"
+      "rampAttack", "rampDecay", "peakBase", "expDecayFactor",
+      "fftSize", "sampleRate", "fftBins"
     };
 
-   const uint8_t AUDIO_PARAM_COUNT = 15;
+   const uint8_t AUDIO_PARAM_COUNT = 18;
 
 
    // for animartrix CK_6 ===================================
@@ -271,6 +273,7 @@ extern uint8_t MODE;
 // ═══════════════════════════════════════════════════════════════════
 
 uint8_t cBright = 35;
+uint8_t cPalNum = 0;       // last requested palette (inPalNum)
 uint8_t cMapping = 0;
 uint8_t cOverrideMapping = 0;
 
@@ -336,6 +339,7 @@ float cOffBase = 1.f;
 float cOffDiff = 1.f; 
 uint8_t cFxIndex = 0;
 uint8_t cColOrd = 0;
+bool intNoise = false;   // integer (Q16.16) Perlin backend for all animARTrix effects
 
 float cRed = 1.f; 
 float cGreen = 1.f; 
@@ -400,6 +404,9 @@ bool updateCycleTiming = false;
 
 // AUDIO -----------------------
 bool maxBins = false;
+bool fixedFft = false;   // Q15 radix-4 FFT backend (fftQ15.h) instead of fl::audio::fft
+bool avPredict = true;   // fire AV responses ahead of tempo-locked beats by the measured latency
+bool melChroma = false;  // mel bands + chroma in AudioFrame (filterbank.h)
 uint16_t cNoiseGateOpen = 70;
 uint16_t cNoiseGateClose = 50;
 float cAudioGain = 1.0f;
@@ -416,6 +423,9 @@ float cRampAttack = 0.f;
 float cRampDecay = 100.f;
 float cPeakBase = 1.0f;
 float cExpDecayFactor = 0.9f;
+uint16_t cFftSize = 1024;      // FFT window: 512 / 1024 / 2048 samples (snapped)
+uint16_t cSampleRate = 44100;  // input rate: 16000 / 22050 / 32000 / 44100 / 48000 (snapped)
+uint8_t cFftBins = 32;         // bands in the wide (maxBins) layout, 16..32
 
 // ═══════════════════════════════════════════════════════════════════
 //  X-MACRO PARAMETER TABLE
@@ -496,3 +506,169 @@ float cExpDecayFactor = 0.9f;
    X(float, RampDecay, 150.f) \
    X(float, PeakBase, 1.0f) \
    X(float, ExpDecayFactor, 1.0f)
+
+// Numeric parameter IDs: PARAMETER_TABLE order, then the Number-characteristic
+// params that live outside it. Used by the binary parameter characteristic;
+// index.html's PARAMETER_IDS must list the same names in the same order.
+// Everything from PID_Bright on is outside preset scope: FftSize/SampleRate/
+// FftBins are venue/analysis settings, and recalling them with a song preset
+// would restart the input mid-show or undo a later venue change.
+enum ParamId : uint8_t {
+   #define X(type, parameter, def) PID_##parameter,
+   PARAMETER_TABLE
+   #undef X
+   PID_Bright,
+   PID_PalNum,
+   PID_FftSize,
+   PID_SampleRate,
+   PID_FftBins,
+   PARAM_ID_COUNT
+};
+
+// Bus parameter IDs (binary records with busId >= 0), in sendBusState() order
+const char* const BUS_PARAM_IDS[] = {
+   "inThreshold", "inMinBeatInterval", "inExpDecayFactor",
+   "inRampAttack", "inRampDecay", "inPeakBase"
+};
+const uint8_t BUS_PARAM_COUNT = 6;
+
+// Same order, as getBusParam() names them
+const char* const BUS_PARAM_NAMES[] = {
+   "threshold", "minBeatInterval", "expDecayFactor",
+   "rampAttack", "rampDecay", "peakBase"
+};
+
+// ═══════════════════════════════════════════════════════════════════
+//  PARAMETER INDEX
+// ═══════════════════════════════════════════════════════════════════
+
+// Per-ParamId metadata generated from PARAMETER_TABLE, and an open-addressed
+// hash index over the names built at compile time. A name resolves with one
+// hash and (normally) one strcasecmp instead of a chain over the whole table.
+// Bounds come from the storage type, so out-of-range writes saturate rather
+// than wrap.
+
+enum ParamType : uint8_t { PARAM_BOOL, PARAM_U8, PARAM_U16, PARAM_FLOAT };
+
+template <typename T> struct ParamTraits;
+template <> struct ParamTraits<bool>     { static constexpr ParamType kind = PARAM_BOOL;  static constexpr float min = 0.0f; static constexpr float max = 1.0f; };
+template <> struct ParamTraits<uint8_t>  { static constexpr ParamType kind = PARAM_U8;    static constexpr float min = 0.0f; static constexpr float max = 255.0f; };
+template <> struct ParamTraits<uint16_t> { static constexpr ParamType kind = PARAM_U16;   static constexpr float min = 0.0f; static constexpr float max = 65535.0f; };
+template <> struct ParamTraits<float>    { static constexpr ParamType kind = PARAM_FLOAT; static constexpr float min = -3.4e38f; static constexpr float max = 3.4e38f; };
+
+// FNV-1a over the lower-cased name (lookups are case-insensitive, as strcasecmp
+// was), with the high bits folded down since the index uses only the low ones
+constexpr uint32_t paramNameHash(const char* s) {
+   uint32_t h = 2166136261u;
+   for (; *s; s++) {
+      const char c = (*s >= 'A' && *s <= 'Z') ? (char)(*s + ('a' - 'A')) : *s;
+      h = (h ^ (uint8_t)c) * 16777619u;
+   }
+   return h ^ (h >> 15);
+}
+
+struct ParamInfo {
+   const char* name;    // PARAMETER_TABLE name ("Zoom"); the BLE ID is "in" + name
+   uint32_t hash;
+   ParamType type;
+   void* ptr;           // the c<Name> global
+   float min;
+   float max;
+};
+
+constexpr ParamInfo PARAM_INFO[PARAM_ID_COUNT] = {
+   #define X(type, parameter, def) \
+      { #parameter, paramNameHash(#parameter), ParamTraits<type>::kind, &c##parameter, ParamTraits<type>::min, ParamTraits<type>::max },
+   PARAMETER_TABLE
+   #undef X
+   { "Bright", paramNameHash("Bright"), PARAM_U8, &cBright, 0.0f, 255.0f },
+   { "PalNum", paramNameHash("PalNum"), PARAM_U8, &cPalNum, 0.0f, 255.0f },
+   { "FftSize", paramNameHash("FftSize"), PARAM_U16, &cFftSize, 0.0f, 65535.0f },
+   { "SampleRate", paramNameHash("SampleRate"), PARAM_U16, &cSampleRate, 0.0f, 65535.0f },
+   { "FftBins", paramNameHash("FftBins"), PARAM_U8, &cFftBins, 0.0f, 255.0f },
+};
+
+constexpr uint16_t PARAM_INDEX_SIZE = 256;     // power of two; 78 names probe at most 3 slots
+constexpr uint8_t PARAM_INDEX_EMPTY = 0xFF;
+static_assert(PARAM_ID_COUNT * 2 <= PARAM_INDEX_SIZE, "grow PARAM_INDEX_SIZE");
+
+struct ParamIndex {
+   uint8_t slot[PARAM_INDEX_SIZE];
+};
+
+constexpr ParamIndex buildParamIndex() {
+   ParamIndex index{};
+   for (uint16_t s = 0; s < PARAM_INDEX_SIZE; s++) index.slot[s] = PARAM_INDEX_EMPTY;
+   for (uint8_t id = 0; id < PARAM_ID_COUNT; id++) {
+      uint16_t s = PARAM_INFO[id].hash & (PARAM_INDEX_SIZE - 1);
+      while (index.slot[s] != PARAM_INDEX_EMPTY) s = (s + 1) & (PARAM_INDEX_SIZE - 1);
+      index.slot[s] = id;
+   }
+   return index;
+}
+
+constexpr ParamIndex PARAM_INDEX = buildParamIndex();
+
+// Hashes are persisted as preset keys, so they must stay distinct
+constexpr bool paramHashesUnique() {
+   for (uint8_t a = 0; a < PARAM_ID_COUNT; a++)
+      for (uint8_t b = a + 1; b < PARAM_ID_COUNT; b++)
+         if (PARAM_INFO[a].hash == PARAM_INFO[b].hash) return false;
+   return true;
+}
+static_assert(paramHashesUnique(), "PARAMETER_TABLE name hash collision");
+
+// ParamId for a table name ("zoom", "Zoom"), or PARAM_ID_COUNT if unknown
+inline uint8_t findParam(const char* name) {
+   const uint32_t h = paramNameHash(name);
+   for (uint16_t s = h & (PARAM_INDEX_SIZE - 1); PARAM_INDEX.slot[s] != PARAM_INDEX_EMPTY;
+        s = (s + 1) & (PARAM_INDEX_SIZE - 1)) {
+      const uint8_t id = PARAM_INDEX.slot[s];
+      if (PARAM_INFO[id].hash == h && strcasecmp(PARAM_INFO[id].name, name) == 0) return id;
+   }
+   return PARAM_ID_COUNT;
+}
+
+// ParamId for a stored paramNameHash() (preset records), or PARAM_ID_COUNT
+inline uint8_t findParamByHash(uint32_t h) {
+   for (uint16_t s = h & (PARAM_INDEX_SIZE - 1); PARAM_INDEX.slot[s] != PARAM_INDEX_EMPTY;
+        s = (s + 1) & (PARAM_INDEX_SIZE - 1)) {
+      const uint8_t id = PARAM_INDEX.slot[s];
+      if (PARAM_INFO[id].hash == h) return id;
+   }
+   return PARAM_ID_COUNT;
+}
+
+// ParamId for a BLE ID ("inZoom")
+inline uint8_t findParamByBleId(const char* bleId) {
+   if (bleId[0] != 'i' || bleId[1] != 'n') return PARAM_ID_COUNT;
+   return findParam(bleId + 2);
+}
+
+// Typed store through PARAM_INFO, saturated to the type's range. NaN/Inf are
+// rejected: clamp passes NaN through, and NaN -> integer is undefined.
+inline bool setParamValue(uint8_t id, float value) {
+   if (id >= PARAM_ID_COUNT || PARAM_INFO[id].ptr == nullptr) return false;
+   if (!isfinite(value)) return false;
+   const ParamInfo& p = PARAM_INFO[id];
+   const float v = fl::clamp(value, p.min, p.max);
+   switch (p.type) {
+      case PARAM_BOOL:  *static_cast<bool*>(p.ptr) = (v != 0.0f); break;
+      case PARAM_U8:    *static_cast<uint8_t*>(p.ptr) = static_cast<uint8_t>(v); break;
+      case PARAM_U16:   *static_cast<uint16_t*>(p.ptr) = static_cast<uint16_t>(v); break;
+      case PARAM_FLOAT: *static_cast<float*>(p.ptr) = v; break;
+   }
+   return true;
+}
+
+inline float getParamValue(uint8_t id, float fallback = 0.0f) {
+   if (id >= PARAM_ID_COUNT || PARAM_INFO[id].ptr == nullptr) return fallback;
+   const ParamInfo& p = PARAM_INFO[id];
+   switch (p.type) {
+      case PARAM_BOOL:  return *static_cast<const bool*>(p.ptr) ? 1.0f : 0.0f;
+      case PARAM_U8:    return *static_cast<const uint8_t*>(p.ptr);
+      case PARAM_U16:   return *static_cast<const uint16_t*>(p.ptr);
+      case PARAM_FLOAT: return *static_cast<const float*>(p.ptr);
+   }
+   return fallback;
+}
@@ -0,0 +1,233 @@
+#pragma once
+
+// =====================================================
+// presetStore.h — Preset slots 1..SLOT_COUNT.
+// Each slot is a binary file on LittleFS (/preset_N.bin:
+// versioned header, CRC-32, one record per parameter
+// keyed by its name hash, bus parameters included) and
+// an in-RAM copy. All files are read once at boot, so
+// recall is a memory copy: no flash, no JSON.
+// Saves go to /preset_N.tmp and are renamed over the .bin,
+// so a power cut leaves the previous preset intact.
+// Legacy /preset_N.json files are converted on first boot.
+// =====================================================
+
+#include <stddef.h>
+#include <FS.h>
+#include "LittleFS.h"
+#include "parameterSchema.h"
+
+namespace presetStore {
+
+    constexpr uint8_t SLOT_COUNT = 20;
+    constexpr uint8_t NO_MODE = 0xFF;                     // program without modes
+    constexpr uint32_t FILE_MAGIC = 0x54535041;           // "APST"
+    constexpr uint8_t FILE_VERSION = 1;
+    constexpr uint8_t GLOBAL_PARAM = 0xFF;                // Record::bus for PARAMETER_TABLE entries
+    constexpr uint8_t STORED_PARAM_COUNT = PID_Bright;    // PARAMETER_TABLE only: no venue settings
+    constexpr uint16_t MAX_RECORDS = STORED_PARAM_COUNT + 3 * BUS_PARAM_COUNT;
+
+    struct FileHeader {
+        uint32_t magic;
+        uint8_t version;
+        uint8_t program;
+        uint8_t mode;
+        uint8_t reserved;
+        uint16_t recordCount;
+        uint16_t reserved2;
+        uint32_t crc;                   // CRC-32 of the header bytes before it, then the records
+    };
+
+    // Keyed by paramNameHash() of the table name ("Zoom") or BLE bus ID
+    // ("inThreshold"), so files survive PARAMETER_TABLE reordering and
+    // additions; unknown keys are skipped on load.
+    struct Record {
+        uint32_t key;
+        float value;
+        uint8_t bus;                    // GLOBAL_PARAM or 0..2
+        uint8_t reserved[3];
+    };
+
+    static_assert(sizeof(FileHeader) == 16 && sizeof(Record) == 12, "preset file layout");
+
+    struct Preset {
+        bool valid = false;
+        uint8_t program = 0;
+        uint8_t mode = NO_MODE;
+        uint32_t paramMask[(STORED_PARAM_COUNT + 31) / 32] = {0};   // which params[] are set
+        float params[STORED_PARAM_COUNT] = {0};
+        uint32_t busMask = 0;                                       // bit = bus * BUS_PARAM_COUNT + i
+        float bus[3][BUS_PARAM_COUNT] = {{0}};
+
+        bool hasParam(uint8_t id) const { return paramMask[id >> 5] & (1u << (id & 31)); }
+        void setParam(uint8_t id, float v) { params[id] = v; paramMask[id >> 5] |= 1u << (id & 31); }
+        bool hasBusParam(uint8_t b, uint8_t i) const { return busMask & (1u << (b * BUS_PARAM_COUNT + i)); }
+        void setBusParam(uint8_t b, uint8_t i, float v) { bus[b][i] = v; busMask |= 1u << (b * BUS_PARAM_COUNT + i); }
+    };
+
+    Preset slots[SLOT_COUNT];           // slots[n - 1] = preset n
+
+    inline bool validNumber(int number) { return number >= 1 && number <= SLOT_COUNT; }
+
+    // CRC-32 (IEEE, reflected), 16-entry table
+    inline uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t len) {
+        static const uint32_t table[16] = {
+            0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+            0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+        };
+        crc = ~crc;
+        for (size_t i = 0; i < len; i++) {
+            crc = table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+            crc = table[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+        }
+        return ~crc;
+    }
+
+    inline uint32_t fileCrc(const FileHeader& header, const Record* records, uint16_t count) {
+        uint32_t crc = crc32Update(0, reinterpret_cast<const uint8_t*>(&header), offsetof(FileHeader, crc));
+        return crc32Update(crc, reinterpret_cast<const uint8_t*>(records), count * sizeof(Record));
+    }
+
+    inline String filename(int number, const char* ext) {
+        String name = "/preset_";
+        name += number;
+        name += ext;
+        return name;
+    }
+
+    //=====================================================================
+
+    // Current program/mode, PARAMETER_TABLE values and bus parameters
+    void capture(Preset& preset) {
+        preset = Preset();
+        preset.valid = true;
+        preset.program = PROGRAM;
+        preset.mode = (MODE_COUNTS[PROGRAM] > 0) ? MODE : NO_MODE;
+        for (uint8_t id = 0; id < STORED_PARAM_COUNT; id++) {
+            preset.setParam(id, getParamValue(id));
+        }
+        if (getBusParam != nullptr) {
+            for (uint8_t b = 0; b < 3; b++) {
+                for (uint8_t i = 0; i < BUS_PARAM_COUNT; i++) {
+                    preset.setBusParam(b, i, getBusParam(b, BUS_PARAM_NAMES[i]));
+                }
+            }
+        }
+    }
+
+    bool writeFile(int number, const Preset& preset) {
+        static Record records[MAX_RECORDS];
+        uint16_t count = 0;
+        for (uint8_t id = 0; id < STORED_PARAM_COUNT; id++) {
+            if (!preset.hasParam(id)) continue;
+            records[count++] = { PARAM_INFO[id].hash, preset.params[id], GLOBAL_PARAM, {0, 0, 0} };
+        }
+        for (uint8_t b = 0; b < 3; b++) {
+            for (uint8_t i = 0; i < BUS_PARAM_COUNT; i++) {
+                if (!preset.hasBusParam(b, i)) continue;
+                records[count++] = { paramNameHash(BUS_PARAM_IDS[i]), preset.bus[b][i], b, {0, 0, 0} };
+            }
+        }
+
+        FileHeader header = { FILE_MAGIC, FILE_VERSION, preset.program, preset.mode, 0, count, 0, 0 };
+        header.crc = fileCrc(header, records, count);
+
+        // Write the whole file aside, then replace the .bin in one rename
+        const String tmpName = filename(number, ".tmp");
+        File file = LittleFS.open(tmpName, "w");
+        if (!file) return false;
+        const size_t bytes = sizeof(header) + count * sizeof(Record);
+        size_t written = file.write(reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+        written += file.write(reinterpret_cast<const uint8_t*>(records), count * sizeof(Record));
+        file.close();
+        if (written != bytes || !LittleFS.rename(tmpName, filename(number, ".bin"))) {
+            LittleFS.remove(tmpName);
+            return false;
+        }
+        return true;
+    }
+
+    bool readFile(int number, Preset& preset) {
+        static Record records[MAX_RECORDS];
+        File file = LittleFS.open(filename(number, ".bin"), "r");
+        if (!file) return false;
+
+        FileHeader header;
+        const bool headerOk = file.read(reinterpret_cast<uint8_t*>(&header), sizeof(header)) == sizeof(header) &&
+                              header.magic == FILE_MAGIC && header.version == FILE_VERSION &&
+                              header.recordCount <= MAX_RECORDS;
+        const size_t recordBytes = headerOk ? header.recordCount * sizeof(Record) : 0;
+        const bool recordsOk = headerOk &&
+                               file.read(reinterpret_cast<uint8_t*>(records), recordBytes) == recordBytes;
+        file.close();
+        if (!recordsOk || fileCrc(header, records, header.recordCount) != header.crc) return false;
+
+        preset = Preset();
+        preset.valid = true;
+        preset.program = header.program;
+        preset.mode = header.mode;
+        for (uint16_t r = 0; r < header.recordCount; r++) {
+            const Record& rec = records[r];
+            if (rec.bus == GLOBAL_PARAM) {
+                const uint8_t id = findParamByHash(rec.key);
+                if (id < STORED_PARAM_COUNT) preset.setParam(id, rec.value);
+            } else if (rec.bus < 3) {
+                for (uint8_t i = 0; i < BUS_PARAM_COUNT; i++) {
+                    if (paramNameHash(BUS_PARAM_IDS[i]) == rec.key) preset.setBusParam(rec.bus, i, rec.value);
+                }
+            }
+        }
+        return true;
+    }
+
+    // Pre-binary format: {"programNum", "modeNum"?, "parameters": {Name: value}}
+    bool readLegacyJson(int number, Preset& preset) {
+        File file = LittleFS.open(filename(number, ".json"), "r");
+        if (!file) return false;
+        ArduinoJson::JsonDocument doc;
+        ArduinoJson::DeserializationError error = deserializeJson(doc, file);
+        file.close();
+        if (error || doc["programNum"].isNull() || doc["parameters"].isNull()) return false;
+
+        preset = Preset();
+        preset.valid = true;
+        preset.program = doc["programNum"].as<uint8_t>();
+        preset.mode = doc["modeNum"].isNull() ? NO_MODE : doc["modeNum"].as<uint8_t>();
+        for (ArduinoJson::JsonPairConst kv : doc["parameters"].as<ArduinoJson::JsonObjectConst>()) {
+            const uint8_t id = findParam(kv.key().c_str());
+            if (id < STORED_PARAM_COUNT) preset.setParam(id, kv.value().as<float>());
+        }
+        return true;
+    }
+
+    // Boot: fill every slot from flash, converting JSON presets once. The JSON is
+    // deleted once its .bin is written, so a later bad .bin can't resurrect it.
+    void loadAll() {
+        uint8_t loaded = 0;
+        for (uint8_t n = 1; n <= SLOT_COUNT; n++) {
+            Preset& slot = slots[n - 1];
+            if (readFile(n, slot)) {
+                loaded++;
+            } else if (readLegacyJson(n, slot)) {
+                if (writeFile(n, slot)) LittleFS.remove(filename(n, ".json"));
+                loaded++;
+            } else {
+                slot = Preset();
+            }
+        }
+        Serial.print("Presets cached: ");
+        Serial.println(loaded);
+    }
+
+    // Save = persist, then update the RAM slot, so recall never returns values
+    // that aren't on flash
+    bool save(int number) {
+        if (!validNumber(number)) return false;
+        static Preset captured;
+        capture(captured);
+        if (!writeFile(number, captured)) return false;
+        slots[number - 1] = captured;
+        return true;
+    }
+
+} // namespace presetStore
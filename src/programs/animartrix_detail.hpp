@@ -81,6 +81,7 @@ License CC BY-NC 3.0
 
 #include "bleControl.h"
 #include "../profiler.h"
+#include "../renderWorker.h"
 
 using namespace fl;
 
@@ -153,6 +154,28 @@ namespace animartrix_detail {
 
     bool bottomCenter = false;
 
+    // Noise backend for render_value()/render_values(). Float is Ken Perlin's
+    // improved noise as ported below; Q16 is the same lattice, permutation and
+    // gradients in integer math (see inoise_q16). Global via the "Integer
+    // noise" checkbox (intNoise); an effect can also opt in by setting
+    // noiseBackend at the top of its body.
+    enum class NoiseBackend : uint8_t { Float, Q16 };
+
+    // Smootherstep 6t^5 - 15t^4 + 10t^3 sampled at 257 points, Q14.
+    // Built once by build_fade_lut(); read by fade_q14().
+    static uint16_t fade_q14_lut[257];
+    static bool fadeLutReady = false;
+
+    void build_fade_lut() {
+        if (fadeLutReady) return;
+        for (int i = 0; i <= 256; i++) {
+            const float t = i / 256.0f;
+            const float f = t * t * t * (t * (t * 6 - 15) + 10);
+            fade_q14_lut[i] = (uint16_t)(f * 16384.0f + 0.5f);
+        }
+        fadeLutReady = true;
+    }
+
     struct render_parameters {
         float center_x = (999 / 2) - 0.5; // center of the matrix
         float center_y = (999 / 2) - 0.5;
@@ -252,10 +275,9 @@ namespace animartrix_detail {
     
     // Audio elements ----------------------------------------------------
 
-    const myAudio::AudioFrame* cFrame = nullptr;
-    myAudio::Bus cBusA;
-    myAudio::Bus cBusB;
-    myAudio::Bus cBusC;
+    myAudio::AudioFrameHandle cFrame;     // this frame's audio; buses are read in place
+    float cResponseA = 0.0f;
+    float cResponseB = 0.0f;
     float cVoxApprox = 0.0f;
 
     float ZoomBusC = 1.f;
@@ -266,11 +288,8 @@ namespace animartrix_detail {
 
     inline void getAudio(myAudio::binConfig& b) {
         b.busBased = true;
-        cFrame = &myAudio::updateAudioFrame(b);
+        cFrame = myAudio::updateAudioFrame(b);
         if (cFrame->valid) {
-            cBusA = cFrame->busA;
-            cBusB = cFrame->busB;
-            cBusC = cFrame->busC;
             cVoxApprox = cFrame->voxApprox;
         }
     }
@@ -338,8 +357,9 @@ namespace animartrix_detail {
 
         ~ANIMartRIX() {}
 
+        // leds[] is the row-major canvas; outputStage does the wiring permutation
         uint16_t xyMap(uint16_t x, uint16_t y) {
-            return mXyMap.mapToIndex(x, y);
+            return y * mXyMap.getWidth() + x;
         }
 
         uint32_t currentTime = 0;
@@ -355,6 +375,8 @@ namespace animartrix_detail {
             this->num_x = w;
             this->num_y = h;
 
+            build_fade_lut();
+
             this->radial_filter_radius = std::min(w,h) * 0.65;
 
             // precalculate all polar coordinates; polar origin is set to matrix center
@@ -387,7 +409,10 @@ namespace animartrix_detail {
             order_b2 = ORDER_TABLE[orderIndex][2];
         }
 
+        NoiseBackend noiseBackend = NoiseBackend::Float;
+
         void render(uint8_t mode) {
+            noiseBackend = intNoise ? NoiseBackend::Q16 : NoiseBackend::Float;
             switch (mode) {
                 case 0: Polar_Waves(); break;
                 case 1: Spiralus(); break;
@@ -505,6 +530,87 @@ namespace animartrix_detail {
                                 grad(P(BB + 1), x1, y1, z1))));
         }
 
+        //***************************************************************
+        // Integer Perlin — pnoise() in Q16.16 coordinates. Same 256-cell
+        // lattice, permutation and 12 gradient directions, so the texture
+        // matches; the fade comes from the smootherstep LUT (linear between
+        // 257 samples) instead of the polynomial. Internally Q14 so every
+        // lerp product fits in 32 bits (|b - a| <= 2^16, t <= 2^14).
+        // Returns Q16 in about -1..+1 (x 65536), like pnoise().
+
+        static int32_t fade_q14(uint32_t frac16) {
+            const uint32_t i = frac16 >> 8;
+            const int32_t a = fade_q14_lut[i];
+            const int32_t b = fade_q14_lut[i + 1];
+            return a + (((b - a) * (int32_t)(frac16 & 255)) >> 8);
+        }
+
+        static int32_t lerp_q14(int32_t t, int32_t a, int32_t b) {
+            return a + (((b - a) * t) >> 14);
+        }
+
+        static int32_t grad_q14(int hash, int32_t x, int32_t y, int32_t z) {
+            int h = hash & 15;
+            int32_t u = h < 8 ? x : y,
+                v = h < 4                ? y
+                    : h == 12 || h == 14 ? x
+                                        : z;
+            return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
+        }
+
+        int32_t inoise_q16(int32_t x, int32_t y, int32_t z) {
+
+            int X = (x >> 16) & 255;
+            int Y = (y >> 16) & 255;
+            int Z = (z >> 16) & 255;
+            const uint32_t fx = (uint32_t)x & 0xFFFF;
+            const uint32_t fy = (uint32_t)y & 0xFFFF;
+            const uint32_t fz = (uint32_t)z & 0xFFFF;
+
+            int32_t u = fade_q14(fx),
+                v = fade_q14(fy),
+                w = fade_q14(fz);
+            int A = P(X) + Y, AA = P(A) + Z,
+                AB = P(A + 1) + Z,
+                B = P(X + 1) + Y, BA = P(B) + Z,
+                BB = P(B + 1) + Z;
+
+            const int32_t x0 = (int32_t)(fx >> 2), x1 = x0 - 16384;
+            const int32_t y0 = (int32_t)(fy >> 2), y1 = y0 - 16384;
+            const int32_t z0 = (int32_t)(fz >> 2), z1 = z0 - 16384;
+
+            const int32_t n = lerp_q14(w,
+                        lerp_q14(v,
+                            lerp_q14(u, grad_q14(P(AA), x0, y0, z0),
+                                grad_q14(P(BA), x1, y0, z0)),
+                            lerp_q14(u, grad_q14(P(AB), x0, y1, z0),
+                                grad_q14(P(BB), x1, y1, z0))),
+                        lerp_q14(v,
+                            lerp_q14(u, grad_q14(P(AA + 1), x0, y0, z1),
+                                grad_q14(P(BA + 1), x1, y0, z1)),
+                            lerp_q14(u, grad_q14(P(AB + 1), x0, y1, z1),
+                                grad_q14(P(BB + 1), x1, y1, z1))));
+            return n * 4;
+        }
+
+        // Float -> Q16.16 keeping the cell index mod 2^16 (the lattice repeats
+        // every 256 cells, so the wrap is invisible)
+        static int32_t to_q16(float v) {
+            const float c = fl::floorf(v);
+            // v just below an integer (e.g. -1e-9) gives v - c == 1.0f after rounding;
+            // 0x10000 would carry into the cell bits, so saturate the fraction
+            const uint32_t frac = FL_MIN((uint32_t)((v - c) * 65536.0f), 0xFFFFu);
+            return (int32_t)(((uint32_t)(int32_t)c << 16) | frac);
+        }
+
+        float pnoise_q16(float x, float y, float z) {
+            return inoise_q16(to_q16(x), to_q16(y), to_q16(z)) * (1.0f / 65536.0f);
+        }
+
+        float noise3(float x, float y, float z) {
+            return noiseBackend == NoiseBackend::Q16 ? pnoise_q16(x, y, z) : pnoise(x, y, z);
+        }
+
         //***************************************************************
 
         // -------------------------------------------------------------------
@@ -682,7 +788,7 @@ namespace animartrix_detail {
                 // rendering could I do?  
 
             // render noisevalue at this new cartesian point
-            float raw_noise_field_value = pnoise(newx, newy, newz);
+            float raw_noise_field_value = noise3(newx, newy, newz);
 
             // A) enhance histogram (improve contrast) by setting the black and
             // white point (low & limitHigh) B) scale the result to a 0-255 range
@@ -703,6 +809,102 @@ namespace animartrix_detail {
             return scaled_noise_value;
         }
 
+        //***************************************************************
+        // Batched render_value — structure-of-arrays over one column.
+        // Effects iterate x outer / y inner, so polar_theta[x][] and
+        // distance[x][] are contiguous along y. The effect fills s.angle[]
+        // and s.dist[] for a layer and sets that layer's constants
+        // (offsets, scales, z, limits) once in `p`. Each stage is its own
+        // loop over contiguous floats: the coordinate transform and the
+        // clamp/map stage vectorize (PIE on P4, SSE/AVX on the host build),
+        // sincos/noise stay scalar (LUT + hash gathers) but lose the
+        // per-pixel struct traffic. Same arithmetic as render_value().
+        //
+        // Scratch is per renderWorker band so both cores can batch at once.
+
+        struct BandScratch {
+            float cos_val[HEIGHT];
+            float sin_val[HEIGHT];
+            float x[HEIGHT];
+            float y[HEIGHT];
+            float angle[HEIGHT];
+            float dist[HEIGHT];
+            float show[9][HEIGHT];
+            uint32_t accum[3];      // per-band stage timings (profiling)
+        };
+
+        BandScratch scratch[2];
+
+        static BandScratch& scratch_for(void* ctx, uint8_t band) {
+            return static_cast<ANIMartRIX*>(ctx)->scratch[band];
+        }
+
+        // Frame-constant inputs of the banded effects, filled before
+        // renderWorker::run() and read-only while the bands render
+        struct CK6Frame {
+            render_parameters layer[3];
+            float twister;
+            float radiusC;
+            float distVoxZoom;
+            float audioBase_red;
+            float audioFactor_blue;
+            float audioFactor_green;
+        } ck6;
+
+        struct FluffyFrame {
+            render_parameters layer[9];
+            float radial_scaled[9];
+            bool layer_on[9];
+        } fluffy;
+
+        void render_values(BandScratch &s, const render_parameters &p,
+                           float *out, int n) {
+
+            for (int i = 0; i < n; i++) {
+                SinCosResult sc = sincos_fast(s.angle[i]);
+                s.cos_val[i] = sc.cos_val;
+                s.sin_val[i] = sc.sin_val;
+            }
+
+            const float base_x = p.offset_x + p.center_x;
+            const float base_y = p.offset_y + p.center_y;
+            const float scale_x = p.scale_x;
+            const float scale_y = p.scale_y;
+            for (int i = 0; i < n; i++) {
+                s.x[i] = (base_x - (s.cos_val[i] * s.dist[i])) * scale_x;
+                s.y[i] = (base_y - (s.sin_val[i] * s.dist[i])) * scale_y;
+            }
+
+            const float newz = (p.offset_z + p.z) * p.scale_z;
+            if (noiseBackend == NoiseBackend::Q16) {
+                const int32_t qz = to_q16(newz);
+                for (int i = 0; i < n; i++) {
+                    out[i] = inoise_q16(to_q16(s.x[i]), to_q16(s.y[i]), qz) * (1.0f / 65536.0f);
+                }
+            } else {
+                for (int i = 0; i < n; i++) {
+                    out[i] = pnoise(s.x[i], s.y[i], newz);
+                }
+            }
+
+            const float lo = p.limitLow;
+            const float hi = p.limitHigh;
+            const float range = hi - lo;
+            for (int i = 0; i < n; i++) {
+                float v = out[i];
+                v = v < lo ? lo : v;
+                v = v > hi ? hi : v;
+                float r = (v - lo) * 255.f / range;
+                r = r < 0.f ? 0.f : r;
+                out[i] = r > 255.f ? 255.f : r;
+            }
+        }
+
+        // Zero-fill for a disabled layer's slot in BandScratch::show
+        void clear_values(float *out, int n) {
+            for (int i = 0; i < n; i++) out[i] = 0.f;
+        }
+
         // render_value using inoise16 (integer Perlin noise) instead of the
         // float pnoise(). Same coordinate transform, same organic texture,
         // but significantly cheaper on ESP32.
@@ -1232,9 +1434,9 @@ namespace animartrix_detail {
                 PROFILE_START("audio_processing");
                 myAudio::binConfig& b = maxBins ? myAudio::bin32 : myAudio::bin16;
                 getAudio(b);
-                myAudio::dynamicPulse(cBusA, cFrame->timestamp);
-                myAudio::dynamicPulse(cBusB, cFrame->timestamp);
-                myAudio::leadResponse(cBusC);
+                cResponseA = myAudio::dynamicPulse(cFrame->busA, cFrame->timestamp);
+                cResponseB = myAudio::dynamicPulse(cFrame->busB, cFrame->timestamp);
+                myAudio::leadResponse();
                 PROFILE_END();
             }
 
@@ -1244,128 +1446,160 @@ namespace animartrix_detail {
              
             if (cRadialSpeed == 0) cRadialSpeed = .001;
 
+            // OPTIMIZATION: Precompute frame-constant values. Everything the
+            // bands read lives in ck6 and is read-only while they run.
             float Twister = cAngle * move.directional[0] * cTwist * TwistBusC*0.2f * (1.f + cVoxApprox*1.25f);
-
-            // OPTIMIZATION: Precompute frame-constant values
             float radius_ck6 = radial_filter_radius * 0.8f * cRadius;
-            float coreRadius_ck6 = radius_ck6 * 0.5f; // compression strength
-            float invCoreRadius = 1.0f / coreRadius_ck6;
             float scaledVoxApprox_ck6 = fl::map_range_clamped<float, float>(cVoxApprox, 0.05f, 0.8f, 0.0f, 0.8f);  // was 0.2 lower bound — reduced dead zone for faster cold start
             // Wider base radius for busC star; more audio-driven dynamic range.
             // voxApprox expands radius with vocal energy; normEMA adds beat-envelope modulation.
-            float radiusC_ck6 = 0.3f * radius_ck6 * (1.f + scaledVoxApprox_ck6 * 2.0f + cBusC.normEMA * 0.4f);
-            float distVoxZoom = (1.f + cVoxApprox) * ZoomBusC;
-            float distDir0_15 = move.directional[0] * 0.15f;  // 0.5f * 0.3f combined
-            float audioBase_red = 0.7f + 0.5f * cBusC.normEMA;  // restored — leadResponse triple-smoothed the signal
-            float audioFactor_blue = cBusA.avResponse;
-            float audioFactor_green = cBusB.avResponse * 0.8f;
-            /*// Precompute z for each layer: (offset_z + z) * scale_z, where scale_z = 0.1
-            float newz1 = (-10.f * move.linear[1] + 100.f * cZ) * 0.1f;
-            float newz2 = (-10.f * move.linear[2] + 25.f * cZ) * 0.1f;
-            float newz3 = (21.f * cZ) * 0.1f;*/
-
-            // Fine-grained pixel loop profiling: uses raw micros() accumulators
-            // to avoid per-pixel overhead of profiler.start()/end() lookups.
-            // Note: ~3 extra micros() calls per pixel adds ~1-2ms measurement overhead.
-            uint32_t accum_noise = 0, accum_radial = 0, accum_compose = 0;
-
-            for (int x = 0; x < num_x; x++) {
-                for (int y = 0; y < num_y; y++) {
+            ck6.radiusC = 0.3f * radius_ck6 * (1.f + scaledVoxApprox_ck6 * 2.0f + cFrame->busC.normEMA * 0.4f);
+            ck6.twister = Twister;
+            ck6.distVoxZoom = (1.f + cVoxApprox) * ZoomBusC;
+            ck6.audioBase_red = 0.7f + 0.5f * cFrame->busC.normEMA;  // restored — leadResponse triple-smoothed the signal
+            ck6.audioFactor_blue = cResponseA;
+            ck6.audioFactor_green = cResponseB * 0.8f;
+
+            // primarily mapped to blue as busA (bass)
+            render_parameters& l1 = ck6.layer[0];
+            l1 = animation;
+            l1.z = 100.f * cZ;
+            l1.scale_x = 0.03f * cScale;
+            l1.scale_y = l1.scale_x;
+            l1.offset_z = -10.f * move.linear[1];
+            l1.offset_y = 10.f * move.noise_angle[1];
+            l1.offset_x = 10.f * move.noise_angle[3];
+
+            // primarily mapped to green as busB (mid)
+            render_parameters& l2 = ck6.layer[1];
+            l2 = animation;
+            l2.z = 25.f * cZ;
+            l2.scale_x = 0.04f * cScale;
+            l2.scale_y = l2.scale_x;
+            l2.offset_z = -10.f * move.linear[2];
+            l2.offset_y = 10.f * move.noise_angle[2];
+            l2.offset_x = 10.f * move.noise_angle[4];
+
+            // primarily mapped to red as busC (vocals/lead)
+            render_parameters& l3 = ck6.layer[2];
+            l3 = animation;
+            l3.z = (21.f) * ZBusC * cZ;
+            l3.scale_x = 0.042f * ScaleBusC;
+            l3.scale_y = l3.scale_x;
+            l3.offset_z = 0.f;
+            l3.offset_y = 5.f;
+            l3.offset_x = 5.f;
+
+            // Per-column stage profiling: raw micros() accumulators around the
+            // batched noise, radial and compose stages, summed over both bands.
+            scratch[0].accum[0] = scratch[0].accum[1] = scratch[0].accum[2] = 0;
+            scratch[1].accum[0] = scratch[1].accum[1] = scratch[1].accum[2] = 0;
+
+            renderWorker::run([](void* ctx, int x0, int x1, uint8_t band) {
+                static_cast<ANIMartRIX*>(ctx)->Complex_Kaleido_6_band(x0, x1, scratch_for(ctx, band));
+            }, this, num_x);
+
+            PROFILE_ACCUMULATE("px_noise",   scratch[0].accum[0] + scratch[1].accum[0]);
+            PROFILE_ACCUMULATE("px_radial",  scratch[0].accum[1] + scratch[1].accum[1]);
+            PROFILE_ACCUMULATE("px_compose", scratch[0].accum[2] + scratch[1].accum[2]);
+        }
 
-                    uint32_t t0 = fl::micros();
+        // Columns [x0, x1) of Complex_Kaleido_6; reads move, ck6 and the polar LUTs only
+        void Complex_Kaleido_6_band(int x0, int x1, BandScratch& s) {
+
+            float* show1c = s.show[0];
+            float* show2c = s.show[1];
+            float* show3c = s.show[2];
+            float* radialC = s.show[3];   // per-pixel busC sunburst dimmer
+
+            for (int x = x0; x < x1; x++) {
+
+                uint32_t t0 = fl::micros();
+
+                if (Layer1) {
+                    for (int y = 0; y < num_y; y++) {
+                        s.dist[y] = distance[x][y] * cZoom * 2.0f;
+                        s.angle[y] =
+                            8.0f * (polar_theta[x][y] * cAngle)
+                            + move.radial[0];
+                            //+ distance[x][y] * move.directional[4];
+                    }
+                    render_values(s, ck6.layer[0], show1c, num_y);
+                } else {
+                    clear_values(show1c, num_y);
+                }
 
-                    // OPTIMIZATION: Cache per-pixel calculations
-                    float polar_theta_angle = polar_theta[x][y] * cAngle;
-                    float dist_zoomed = distance[x][y] * cZoom;
+                if (Layer2) {
+                    for (int y = 0; y < num_y; y++) {
+                        s.dist[y] = distance[x][y] * cZoom;
+                        s.angle[y] =
+                            8.0f * (polar_theta[x][y] * cAngle)
+                            - move.radial[1]
+                            + distance[x][y] * 0.5f * move.directional[0] * .3f;
+                    }
+                    render_values(s, ck6.layer[1], show2c, num_y);
+                } else {
+                    clear_values(show2c, num_y);
+                }
 
-                   // primarily mapped to blue as busA (bass)
-                    animation.dist = dist_zoomed * 2.0f;
-                    animation.angle =
-                        8.0f * polar_theta_angle
-                        + move.radial[0];
-                        //+ distance[x][y] * move.directional[4];
-                    animation.z = 100.f * cZ;
-                    animation.scale_x = 0.03f * cScale;
-                    animation.scale_y = animation.scale_x;
-                    animation.offset_z = -10.f * move.linear[1];
-                    animation.offset_y = 10.f * move.noise_angle[1];
-                    animation.offset_x = 10.f * move.noise_angle[3];
-                    show1 = { Layer1 ? render_value(animation) : 0};
+                if (Layer3) {
+                    for (int y = 0; y < num_y; y++) {
+                        s.dist[y] = (distance[x][y] * cZoom) * ck6.distVoxZoom;
+                        s.angle[y] =
+                            polar_theta[x][y] * AngleBusC * cAngle                      // ~how many "arms/rays" there are
+                            + 2.0f * move.radial[7] * cRadialSpeed //* cBusC.spinRate     // how fast this layer rotates around the center point
+                            + 0.8f*distance[x][y] * ck6.twister; //* move.noise_angle[5]; // how much twist/spiral there is moving out from center
+                            //+ move.directional[3];                                    // an oscilating [-1,+1] adjustment to rotational speed
+                    }
+                    render_values(s, ck6.layer[2], show3c, num_y);
+                } else {
+                    clear_values(show3c, num_y);
+                }
 
-                    // primarily mapped to green as busB (mid)
-                    animation.dist = dist_zoomed;
-                    animation.angle =
-                        8.0f * polar_theta_angle
-                        - move.radial[1]
-                        + distance[x][y] * 0.5f * move.directional[0] * .3f;
-                    animation.z = 25.f * cZ;
-                    animation.scale_x = 0.04f * cScale;
-                    animation.scale_y = animation.scale_x;
-                    animation.offset_z = -10.f * move.linear[2];
-                    animation.offset_y = 10.f * move.noise_angle[2];
-                    animation.offset_x = 10.f * move.noise_angle[4];
-                    show2 = { Layer2 ? render_value(animation) : 0};
+                uint32_t t1 = fl::micros();
 
-                    // primarily mapped to red as busC (vocals/lead)
-                    animation.dist = dist_zoomed * distVoxZoom ;
-                    animation.angle =
-                        polar_theta[x][y] * AngleBusC * cAngle                      // ~how many "arms/rays" there are
-                        + 2.0f * move.radial[7] * cRadialSpeed //* cBusC.spinRate     // how fast this layer rotates around the center point
-                        + 0.8f*distance[x][y] * Twister; //* move.noise_angle[5];   // how much twist/spiral there is moving out from center
-                        //+ move.directional[3];                                    // an oscilating [-1,+1] adjustment to rotational speed
-                    animation.z = (21.f) * ZBusC * cZ;
-                    animation.scale_x = 0.042f * ScaleBusC;
-                    animation.scale_y = animation.scale_x;
-                    animation.offset_z = 0.f;
-                    animation.offset_y = 5.f;
-                    animation.offset_x = 5.f;
-
-                    show3 = Layer3 ? render_value(animation) : 0;
-
-                    uint32_t t1 = fl::micros();
-
-                    //float radius = radial_filter_radius * cRadius;
-                    //float scaledVoxApprox = fl::map_range_clamped<float, float>(cVoxApprox, 0.2f, 0.8f, 0.0f, 0.8f);
-                    //float radiusC = 0.4f*radial_filter_radius * cRadius * (1.f + scaledVoxApprox);
-
-                    radialDimmer = radialFilterFactor(radius_ck6, distance[x][y], cEdge);
-                    // "sunburst" radial filter for busC:
-                    // Bright Perlin noise extends the effective radius per-pixel,
-                    // so the boundary follows the noise structure — irregular animated rays.
-                    // Soft quartic falloff (no hard cutoff, cheaper than powf).
-                    //   0.5f = how much bright noise extends the boundary (0=none, 1=double)
-                    float show3_push = show3 * (1.0f / 255.0f);
-                    float effRadC = FL_MAX(radiusC_ck6 * (1.0f + show3_push * 0.8f), 0.01f);
+                // "sunburst" radial filter for busC:
+                // Bright Perlin noise extends the effective radius per-pixel,
+                // so the boundary follows the noise structure — irregular animated rays.
+                // Soft quartic falloff (no hard cutoff, cheaper than powf).
+                //   0.8f = how much bright noise extends the boundary (0=none, 1=double)
+                for (int y = 0; y < num_y; y++) {
+                    float show3_push = show3c[y] * (1.0f / 255.0f);
+                    float effRadC = FL_MAX(ck6.radiusC * (1.0f + show3_push * 0.8f), 0.01f);
                     float dRatioC = distance[x][y] / effRadC;
                     float softEdge = FL_MAX(0.0f, 1.0f - dRatioC * dRatioC);
-                    radialDimmerC = softEdge * softEdge;
+                    radialC[y] = softEdge * softEdge;
+                }
 
-                    uint32_t t2 = fl::micros();
+                uint32_t t2 = fl::micros();
+
+                for (int y = 0; y < num_y; y++) {
+
+                    const float s1 = show1c[y];
+                    const float s2 = show2c[y];
+                    const float s3 = show3c[y];
+                    float audioFactor_red = ck6.audioBase_red * FL_MAX(radialC[y], 0.01f);
 
-                    float audioFactor_red = audioBase_red * FL_MAX(radialDimmerC, 0.01f);
-                    
                     // Cross-layer modulation (layers shape each other)
                        // one layer dims another multiplicatively. Creates softer transitions —
                        // no hard black gaps, but colors still separate. The /512.f controls how aggressively
                        // the cross-layer dims (at show=256, it halves the primary).
-                    pixel.red   = cRed * 1.5f*show3 * (1.0f - show1/1024.f) * (1.0f - show2/1024.f) * audioFactor_red;
-                    pixel.green = cGreen * 0.75f*show2 * (1.0f - show3/384.f) * (1.0f - show1/512.f) * audioFactor_green;
-                    pixel.blue  = cBlue * show1 * (1.0f - show2/512.f) * (1.0f - show3/384.f) * audioFactor_blue;
+                    rgb px;
+                    px.red   = cRed * 1.5f*s3 * (1.0f - s1/1024.f) * (1.0f - s2/1024.f) * audioFactor_red;
+                    px.green = cGreen * 0.75f*s2 * (1.0f - s3/384.f) * (1.0f - s1/512.f) * ck6.audioFactor_green;
+                    px.blue  = cBlue * s1 * (1.0f - s2/512.f) * (1.0f - s3/384.f) * ck6.audioFactor_blue;
 
-                    pixel = rgb_sanity_check(pixel);
+                    px = rgb_sanity_check(px);
 
-                    setPixelColorInternal(x, y, pixel);
+                    setPixelColorInternal(x, y, px);
+                }
 
-                    uint32_t t3 = fl::micros();
+                uint32_t t3 = fl::micros();
 
-                    accum_noise   += (t1 - t0);
-                    accum_radial  += (t2 - t1);
-                    accum_compose += (t3 - t2);
-                }
+                s.accum[0] += (t1 - t0);
+                s.accum[1] += (t2 - t1);
+                s.accum[2] += (t3 - t2);
             }
-            PROFILE_ACCUMULATE("px_noise",   accum_noise);
-            PROFILE_ACCUMULATE("px_radial",  accum_radial);
-            PROFILE_ACCUMULATE("px_compose", accum_compose);
         }
 
         //*******************************************************************************
@@ -1639,146 +1873,79 @@ namespace animartrix_detail {
 
             calculate_timers(timings);
     
-            // OPTIMIZATION: Pre-calculate per-frame values (used for all pixels)
-            float radial_scaled[9];
-            float linear_scaled[9];
+            // OPTIMIZATION: Pre-calculate per-frame values (used for all pixels).
+            // Per-layer constants: offset_z multiplier and blob size factor.
+            // Layer1 also carries the parameters the others inherit, so toggling
+            // it only affects display; toggling other layers skips their work.
+            static const float layer_z[9] = {0, 200, 400, 600, 800, 1800, 2800, 3800, 4800};
+            static const double layer_size[9] = {1.0, 1.1, 1.2, 1.0, 1.1, 1.2, 1.0, 1.1, 1.2};
+            const bool layer_on[9] = {Layer1, Layer2, Layer3, Layer4, Layer5, Layer6, Layer7, Layer8, Layer9};
+
+            animation.z = 0.5f;
+            animation.limitLow = 0.0f;
+            animation.limitHigh = 1.0f;
+
             for (int i = 0; i < 9; i++) {
-                radial_scaled[i] = cRadialSpeed * move.radial[i];
-                linear_scaled[i] = cLinearSpeed * move.linear[i];
+                render_parameters& p = fluffy.layer[i];
+                p = animation;
+                p.offset_y = cLinearSpeed * move.linear[i];
+                p.offset_z = layer_z[i] * cZ;
+                p.scale_x = size * layer_size[i] * cScale;
+                p.scale_y = p.scale_x;
+                fluffy.radial_scaled[i] = cRadialSpeed * move.radial[i];
+                fluffy.layer_on[i] = layer_on[i];
             }
 
-            for (int x = 0; x < num_x; x++) {
+            renderWorker::run([](void* ctx, int x0, int x1, uint8_t band) {
+                static_cast<ANIMartRIX*>(ctx)->Fluffy_Blobs_band(x0, x1, scratch_for(ctx, band));
+            }, this, num_x);
+
+        } // Fluffy_Blobs
+
+        // Columns [x0, x1) of Fluffy_Blobs; reads move, fluffy and the polar LUTs only
+        void Fluffy_Blobs_band(int x0, int x1, BandScratch& s) {
+
+            for (int x = x0; x < x1; x++) {
+
+                // OPTIMIZATION: per-column polar inputs shared by all 9 layers
                 for (int y = 0; y < num_y; y++) {
+                    s.dist[y] = distance[x][y] * cZoom;
+                }
 
                 // render 9 layers with the same effect at slighliy different speeds and sizes
+                for (int i = 0; i < 9; i++) {
+                    if (!fluffy.layer_on[i]) {
+                        clear_values(s.show[i], num_y);
+                        continue;
+                    }
+                    const float radial = fluffy.radial_scaled[i];
+                    for (int y = 0; y < num_y; y++) {
+                        s.angle[y] = polar_theta[x][y] * cAngle + radial;
+                    }
+                    render_values(s, fluffy.layer[i], s.show[i], num_y);
+                }
 
-                // OPTIMIZATION: Cache per-pixel calculations
-                float polar_theta_angle = polar_theta[x][y] * cAngle;
-                float dist_zoomed = distance[x][y] * cZoom;
-
-                // Layer1
-                /* Includes parameters that are used in subsequent layers if unchanged;
-                    so toggling Layer1 only affects display, not processing. Toggling other layers
-                    determines whether they even process. */
-                //animation.dist = distance[x][y] * cZoom ;
-                //animation.angle = polar_theta[x][y] * cAngle + (cRadialSpeed * move.radial[0]);
-                animation.dist = dist_zoomed;
-                animation.angle = polar_theta_angle + radial_scaled[0];
-                animation.z = 0.5f;
-                animation.scale_x = size * cScale;
-                animation.scale_y = size * cScale;
-                animation.offset_z = 0.0f;
-                //animation.offset_y = cLinearSpeed * move.linear[0];
-                animation.offset_y = linear_scaled[0];
-                animation.limitLow = 0.0f;
-                animation.limitHigh = 1.0f;
-    
-                show1 = { Layer1 ? render_value(animation) : 0};
-                
-                if (Layer2) {
-                    //animation.angle = polar_theta[x][y] * cAngle + (cRadialSpeed *  move.radial[1]);
-                    //animation.offset_y = cLinearSpeed * move.linear[1];
-                    animation.angle = polar_theta_angle + radial_scaled[1];
-                    animation.offset_y = linear_scaled[1];
-                    animation.offset_z = 200 * cZ;
-                    animation.scale_x = size * 1.1 * cScale;
-                    animation.scale_y = size * 1.1 * cScale;
-                    show2 = render_value(animation);
-                } else {show2 = 0;}
-                
-                if (Layer3) {
-                    //animation.angle = polar_theta[x][y] * cAngle + (cRadialSpeed *  move.radial[2]);
-                    //animation.offset_y = cLinearSpeed * move.linear[2];
-                    animation.angle = polar_theta_angle + radial_scaled[2];
-                    animation.offset_y = linear_scaled[2];
-                    animation.offset_z = 400 * cZ;
-                    animation.scale_x = size * 1.2 * cScale;
-                    animation.scale_y = size * 1.2 * cScale;
-                    show3 = render_value(animation);
-                } else {show3 = 0;}
-
-                if (Layer4) {
-                    //animation.angle = polar_theta[x][y] * cAngle + (cRadialSpeed *  move.radial[3]);
-                    //animation.offset_y = cLinearSpeed * move.linear[3];
-                    animation.angle = polar_theta_angle + radial_scaled[3];
-                    animation.offset_y = linear_scaled[3];
-                    animation.offset_z = 600 * cZ;
-                    animation.scale_x = size * cScale;
-                    animation.scale_y = size * cScale;
-                    show4 = render_value(animation);
-                } else {show4 = 0;}
-                
-                if (Layer5) {
-                    //animation.angle = polar_theta[x][y] * cAngle + (cRadialSpeed *  move.radial[4]);
-                    //animation.offset_y = cLinearSpeed * move.linear[4];
-                    animation.angle = polar_theta_angle + radial_scaled[4];
-                    animation.offset_y = linear_scaled[4];
-                    animation.offset_z = 800 * cZ;
-                    animation.scale_x = size * 1.1 * cScale;
-                    animation.scale_y = size * 1.1 * cScale;
-                    show5 = render_value(animation);
-                } else {show5 = 0;}
-                
-                if (Layer6) {
-                    //animation.angle = polar_theta[x][y]  * cAngle + (cRadialSpeed *  move.radial[5]);
-                    //animation.offset_y = cLinearSpeed * move.linear[5];
-                    animation.angle = polar_theta_angle + radial_scaled[5];
-                    animation.offset_y = linear_scaled[5];
-                    animation.offset_z = 1800 * cZ;
-                    animation.scale_x = size * 1.2 * cScale;
-                    animation.scale_y = size * 1.2 * cScale;
-                    show6 = render_value(animation);
-                } else {show6 = 0;}
-                
-                if (Layer7) {
-                    //animation.angle = polar_theta[x][y] * cAngle + (cRadialSpeed *  move.radial[6]);
-                    //animation.offset_y = cLinearSpeed * move.linear[6];
-                    animation.angle = polar_theta_angle + radial_scaled[6];
-                    animation.offset_y = linear_scaled[6];
-                    animation.offset_z = 2800 * cZ;
-                    animation.scale_x = size * cScale;
-                    animation.scale_y = size * cScale;
-                    show7 = render_value(animation);
-                } else {show7 = 0;}
-
-                if (Layer8) {
-                    //animation.angle = polar_theta[x][y] * cAngle + (cRadialSpeed *  move.radial[7]);
-                    //animation.offset_y = cLinearSpeed  * move.linear[7];
-                    animation.angle = polar_theta_angle + radial_scaled[7];
-                    animation.offset_y = linear_scaled[7];
-                    animation.offset_z = 3800 * cZ;
-                    animation.scale_x = size * 1.1 * cScale;
-                    animation.scale_y = size * 1.1 * cScale;
-                    show8 = render_value(animation);
-                } else {show8 = 0;}
-
-                if (Layer9) {
-                    //animation.angle = polar_theta[x][y] * cAngle + (cRadialSpeed *  move.radial[8]);
-                    //animation.offset_y = cLinearSpeed  * move.linear[8];
-                    animation.angle = polar_theta_angle + radial_scaled[8];
-                    animation.offset_y = linear_scaled[8];
-                    animation.offset_z = 4800 * cZ;
-                    animation.scale_x = size * 1.2 * cScale;
-                    animation.scale_y = size * 1.2 * cScale;
-                    show9 = render_value(animation);
-                } else {show9 = 0;}
-
-                // the factors modulate the color mix and overall appearance of the animations
-
-                pixel.red = ( (show1 + show2 + show3) + (show4 + show5 + show6)) * cRed;   // red is the sum of layer 1, 2, 3
-                                                                                        // I also add layer 4, 5, 6 (which modulates green)
-                                                                                        // in order to add orange/yellow to the mix
-                pixel.green = (0.8 * (show4 + show5 + show6)) * cGreen;                           // green is the sum of layer 4, 5, 6
-                pixel.blue =  (0.3 * (show7 + show8 + show9)) * cBlue;                           // blue is the sum of layer 7, 8, 9
+                for (int y = 0; y < num_y; y++) {
 
-                pixel = rgb_sanity_check(pixel);
+                    const float s1 = s.show[0][y], s2 = s.show[1][y], s3 = s.show[2][y];
+                    const float s4 = s.show[3][y], s5 = s.show[4][y], s6 = s.show[5][y];
+                    const float s7 = s.show[6][y], s8 = s.show[7][y], s9 = s.show[8][y];
 
-                setPixelColorInternal(x, y, pixel);
+                    // the factors modulate the color mix and overall appearance of the animations
+
+                    rgb px;
+                    px.red = ( (s1 + s2 + s3) + (s4 + s5 + s6)) * cRed;   // red is the sum of layer 1, 2, 3
+                                                                         // I also add layer 4, 5, 6 (which modulates green)
+                                                                         // in order to add orange/yellow to the mix
+                    px.green = (0.8 * (s4 + s5 + s6)) * cGreen;             // green is the sum of layer 4, 5, 6
+                    px.blue =  (0.3 * (s7 + s8 + s9)) * cBlue;             // blue is the sum of layer 7, 8, 9
+
+                    px = rgb_sanity_check(px);
 
+                    setPixelColorInternal(x, y, px);
                 }
             }
-        
-        } // Fluffy_Blobs
+        }
 
 
         void Test3() {
@@ -51,10 +51,10 @@ namespace audioTest {
 		}
 		
 		// Calculate bar width - spread bins across WIDTH
-		uint8_t barWidth = WIDTH / b.NUM_FFT_BINS;
+		uint8_t barWidth = WIDTH / frame.numBins;
 		if (barWidth < 1) barWidth = 1;
 
-		for (uint8_t bin = 0; bin < b.NUM_FFT_BINS; bin++) {
+		for (uint8_t bin = 0; bin < frame.numBins; bin++) {
 			// Use raw linear amplitude — no dB spectral tilt, no avLeveler
 			float mag = frame.fft_pre[bin];
 
@@ -195,8 +195,8 @@ namespace audioTest {
 	//===============================================================================================
 	// VISUALIZATION MODE 4: Latency Test
 	// Three horizontal bands mirroring the exact audio response chain used in CK6:
-	//   Bottom (blue)  = busA.avResponse          (dynamicPulse, bass)
-	//   Middle (green) = busB.avResponse * 0.8    (dynamicPulse, mid)
+	//   Bottom (blue)  = dynamicPulse(busA)       (bass)
+	//   Middle (green) = dynamicPulse(busB) * 0.8 (mid)
 	//   Top    (red)   = lead/vocal response      (voxApprox + busC.normEMA)
 	//===============================================================================================
 
@@ -211,16 +211,17 @@ namespace audioTest {
 		uint32_t now = frame.timestamp;
 		bool gateOpen = myAudio::noiseGateOpen;
 
-		// Same avResponse calls as CK6
-		myAudio::dynamicPulse(myAudio::busA, now);
-		myAudio::dynamicPulse(myAudio::busB, now);
-		myAudio::leadResponse(myAudio::busC);
+		// Same response calls as CK6, on the published frame's buses (the
+		// global buses belong to the audio task)
+		const float responseA = myAudio::dynamicPulse(frame.busA, now);
+		const float responseB = myAudio::dynamicPulse(frame.busB, now);
+		const float responseLead = myAudio::leadResponse();
 
 		// Audio factors — identical to CK6's precomputed values
-		float audioFactor_blue  = gateOpen ? myAudio::busA.avResponse : 0.0f;
-		float audioFactor_green = gateOpen ? myAudio::busB.avResponse * 0.8f : 0.0f;
+		float audioFactor_blue  = gateOpen ? responseA : 0.0f;
+		float audioFactor_green = gateOpen ? responseB * 0.8f : 0.0f;
 		// Red uses leadResponse envelope, same as CK6's audioBase_red
-		float audioFactor_red   = gateOpen ? (0.7f + 0.5f * myAudio::busC.avResponse) : 0.0f;
+		float audioFactor_red   = gateOpen ? (0.7f + 0.5f * responseLead) : 0.0f;
 
 		// Layout: two vertical columns on left, red square centered in remaining space
 		uint8_t colWidth = FL_MAX(WIDTH / 5, 1);          // ~20% of WIDTH each
@@ -233,7 +234,7 @@ namespace audioTest {
 		uint8_t sq_x0 = remaining_x0 + (remaining_w - sqSize) / 2;
 		uint8_t sq_y0 = (HEIGHT - sqSize) / 2;
 
-		// Left column: blue = busA.avResponse
+		// Left column: blue = busA pulse
 		uint8_t blueBri = (uint8_t)(fl::clamp(audioFactor_blue, 0.0f, 1.0f) * 255);
 		for (uint8_t y = 0; y < HEIGHT; y++) {
 			for (uint8_t x = colA_x0; x < colA_x0 + colWidth; x++) {
@@ -241,7 +242,7 @@ namespace audioTest {
 			}
 		}
 
-		// Second column: green = busB.avResponse * 0.8
+		// Second column: green = busB pulse * 0.8
 		uint8_t greenBri = (uint8_t)(fl::clamp(audioFactor_green, 0.0f, 1.0f) * 255);
 		for (uint8_t y = 0; y < HEIGHT; y++) {
 			for (uint8_t x = colB_x0; x < colB_x0 + colWidth; x++) {
@@ -274,7 +275,7 @@ namespace audioTest {
 		int centerY = HEIGHT / 2;
 
 		for (size_t angle = 0; angle < 360; angle += 2) {  // Reduced resolution
-			size_t band = (angle / 2) % b.NUM_FFT_BINS;
+			size_t band = (angle / 2) % frame.numBins;
 
 			float magnitude = frame.fft_norm[band];
 
@@ -389,35 +390,41 @@ namespace audioTest {
 		
 		if (!frame.valid) { return;	}
 
-		// Scroll existing image down by 1 row (time axis)
-		for (int y = HEIGHT - 1; y > 0; y--) {
-			for (int x = 0; x < WIDTH; x++) {
-				uint16_t dst = xyFunc(x, y);
-				uint16_t src = xyFunc(x, y - 1);
-				leds[dst] = leds[src];
+		// Emphasize dynamic range: soft floor + log compression + gamma (as a LUT,
+		// since every row is redrawn each frame). The LUT is indexed by the linear
+		// magnitude before the curve, and the curve is steepest at the low end, so it
+		// needs far more than 256 input steps or quiet bins collapse into a few bands.
+		constexpr uint16_t MAG_LUT_SIZE = 1024;
+		static uint8_t magLut[MAG_LUT_SIZE];
+		static bool magLutReady = false;
+		if (!magLutReady) {
+			for (int i = 0; i < MAG_LUT_SIZE; i++) {
+				float mag = FL_MAX(0.0f, i / (float)(MAG_LUT_SIZE - 1) - 0.01f);
+				float magLog = fl::log10f(1.0f + mag * 9.0f) / fl::log10f(10.0f);
+				float magGamma = fl::powf(magLog, 0.7f);
+				magLut[i] = (uint8_t)fl::clamp(magGamma * 255.0f, 0.0f, 255.0f);
 			}
+			magLutReady = true;
 		}
 
-		// Draw newest FFT slice at top row
-		for (int x = 0; x < WIDTH; x++) {
-			float pos = (WIDTH > 1) ? (float)x * (b.NUM_FFT_BINS - 1) / (float)(WIDTH - 1) : 0.0f;
-			int bin0 = (int)pos;
-			int bin1 = (bin0 + 1 < b.NUM_FFT_BINS) ? (bin0 + 1) : bin0;
-			float t = pos - (float)bin0;
-
-			float mag = frame.fft_norm[bin0] * (1.0f - t) + frame.fft_norm[bin1] * t;
-
-			// Emphasize dynamic range: soft floor + log compression + gamma
-			mag = FL_MAX(0.0f, mag - 0.01f);
-			float magLog = fl::log10f(1.0f + mag * 9.0f) / fl::log10f(10.0f);
-			float magGamma = fl::powf(magLog, 0.7f);
-
-			uint8_t colorIndex = (uint8_t)fl::clamp(magGamma * 255.0f, 0.0f, 255.0f);
-			CRGB color = ColorFromPalette(audioTestPalette, colorIndex);
-			color.nscale8((uint8_t)fl::clamp(magGamma * 255.0f, 0.0f, 255.0f));
+		// Row y shows the FFT slice from y frames ago (newest at the top)
+		const FeatureHistory& hist = myAudio::featureHistory;
+		for (int y = 0; y < HEIGHT; y++) {
+			for (int x = 0; x < WIDTH; x++) {
+				uint16_t idx = xyFunc(x, y);
+				if (y >= hist.size()) {
+					leds[idx] = CRGB::Black;
+					continue;
+				}
+				const uint8_t numBins = hist.at(y).numBins;
+				float pos = (WIDTH > 1) ? (float)x * (numBins - 1) / (float)(WIDTH - 1) : 0.0f;
+				float mag = hist.sampleFft(y, pos);
 
-			uint16_t idx = xyFunc(x, 0);
-			leds[idx] = color;
+				uint8_t level = magLut[(uint16_t)fl::clamp(mag * (MAG_LUT_SIZE - 1), 0.0f, (float)(MAG_LUT_SIZE - 1))];
+				CRGB color = ColorFromPalette(audioTestPalette, level);
+				color.nscale8(level);
+				leds[idx] = color;
+			}
 		}
 	}
 
@@ -437,9 +444,9 @@ namespace audioTest {
 		fadeToBlackBy(leds, NUM_LEDS, 40);
 
 		for (int x = 0; x < WIDTH; x++) {
-			float pos = (WIDTH > 1) ? (float)x * (b.NUM_FFT_BINS - 1) / (float)(WIDTH - 1) : 0.0f;
+			float pos = (WIDTH > 1) ? (float)x * (frame.numBins - 1) / (float)(WIDTH - 1) : 0.0f;
 			int bin0 = (int)pos;
-			int bin1 = (bin0 + 1 < b.NUM_FFT_BINS) ? (bin0 + 1) : bin0;
+			int bin1 = (bin0 + 1 < frame.numBins) ? (bin0 + 1) : bin0;
 			float t = pos - (float)bin0;
 
 			float mag = frame.fft_norm[bin0] * (1.0f - t) + frame.fft_norm[bin1] * t;
@@ -476,14 +483,16 @@ namespace audioTest {
 		bool gateOpen = myAudio::noiseGateOpen;
 
 		// Always call dynamicPulse so ramps decay naturally even during silence
-		dynamicPulse(myAudio::busA, now);
-		dynamicPulse(myAudio::busB, now);
-		dynamicPulse(myAudio::busC, now);
+		const float responses[3] = {
+			dynamicPulse(frame.busA, now),
+			dynamicPulse(frame.busB, now),
+			dynamicPulse(frame.busC, now)
+		};
 
 		const uint8_t barCols = (uint8_t)(WIDTH * 0.75f);
 
 		// Draw one bus row-band: level meter on the left, beat flash on the right
-		auto drawBus = [&](myAudio::Bus& bus, uint8_t startRow, uint8_t busHue) {
+		auto drawBus = [&](const myAudio::Bus& bus, uint8_t startRow, uint8_t busHue) {
 			// Level meter suppressed when gate is closed (gain calibration can amplify noise)
 			float level = gateOpen ? bus.norm : 0.0f;
 			uint8_t filledCols = (uint8_t)(level * barCols);
@@ -500,7 +509,7 @@ namespace audioTest {
 			}
 
 			// Beat flash zone: barCols to WIDTH-1 (suppressed when gate is closed)
-			uint8_t flash = gateOpen ? (uint8_t)(fl::clamp(bus.avResponse, 0.0f, 1.0f) * 255) : 0;
+			uint8_t flash = gateOpen ? (uint8_t)(fl::clamp(responses[bus.id], 0.0f, 1.0f) * 255) : 0;
 			if (flash > 0) {
 				CRGB flashColor = CHSV(busHue, 150, flash);
 				for (uint8_t x = barCols; x < WIDTH; x++) {
@@ -514,9 +523,9 @@ namespace audioTest {
 			}
 		};
 
-		drawBus(myAudio::busA, 0,              0);    // Red   (bass)
-		drawBus(myAudio::busB, BUS_ROWS,       96);   // Green (mid)
-		drawBus(myAudio::busC, 2 * BUS_ROWS,   160);  // Blue  (treble)
+		drawBus(frame.busA, 0,              0);    // Red   (bass)
+		drawBus(frame.busB, BUS_ROWS,       96);   // Green (mid)
+		drawBus(frame.busC, 2 * BUS_ROWS,   160);  // Blue  (treble)
 	*/
 	}
 
@@ -276,7 +276,7 @@ namespace cube {
 
 	void runCube() {
 
-		FastLED.clear();
+		fill_solid(leds, NUM_LEDS, CRGB::Black);
 
 		rotateCube();
 		
@@ -118,7 +118,7 @@ namespace dots {
 		
 		VerticalStream(110 * cTail);
 		//HorizontalStream(75);
-		FastLED.delay(5);
+		showPipeline::pace(5);
 	}
 
 } // namespace dots
\ No newline at end of file
@@ -72,7 +72,7 @@ namespace radii {
 
 	void runRadii() {
 
-		FastLED.clear();
+		fill_solid(leds, NUM_LEDS, CRGB::Black);
 
 		uint8_t speed = cSpeedInt;
 		switch(MODE){
@@ -144,7 +144,7 @@ namespace radii {
 			}
 		}
 		
-		FastLED.delay(15);
+		showPipeline::pace(15);
 	}
 
 } // namespace radii
\ No newline at end of file
@@ -8,14 +8,6 @@
 #include "bleControl.h"
 #include "profiler.h"
 
-// Forward-declare the LED-mapping arrays defined globally (via matrixMap_*.h
-// included by main.cpp). synaptide caches the active pointer once per frame
-// to bypass the xyFunc() switch/function-call overhead in its hot loops.
-extern const uint16_t progTopDown[NUM_LEDS] PROGMEM;
-extern const uint16_t progBottomUp[NUM_LEDS] PROGMEM;
-extern const uint16_t serpTopDown[NUM_LEDS] PROGMEM;
-extern const uint16_t serpBottomUp[NUM_LEDS] PROGMEM;
-
 namespace synaptide {
 
     //using namespace fl;
@@ -27,12 +19,43 @@ namespace synaptide {
     void initMatrix();
     void initSynaptide(uint16_t (*xy_func)(uint8_t, uint8_t));
 
-    static float matrix1[NUM_LEDS];
-    static float matrix2[NUM_LEDS];
+    // Simulation grids in row-major spatial order with a one-cell halo on every
+    // side. The halo mirrors the opposite edge (the field is a torus), so the
+    // 3x3 neighbor reads in tick() are fixed offsets from the cell with no
+    // wrap arithmetic or mapping lookups. LED order only appears in drawMatrix().
+    constexpr int GRID_PITCH = WIDTH + 2;
+    constexpr int GRID_ROWS = HEIGHT + 2;
+    constexpr int GRID_CELLS = GRID_PITCH * GRID_ROWS;
+
+    static float matrix1[GRID_CELLS];
+    static float matrix2[GRID_CELLS];
     static float *matrix = matrix1;
     static float *lastMatrix = matrix2;
     static bool useMatrix1 = true;
 
+    inline int cell(int x, int y) { return (y + 1) * GRID_PITCH + (x + 1); }
+
+    // Wrapped coordinate for a halo-relative index (0 = -1, 1..N = 0..N-1, N+1 = N)
+    static uint8_t wrapX_LUT[WIDTH + 2];
+    static uint8_t wrapY_LUT[HEIGHT + 2];
+
+    // Refresh the halo from the opposite interior edges (corners included)
+    void wrapHalo(float *grid) {
+        float *top = grid;
+        float *bottom = grid + (GRID_ROWS - 1) * GRID_PITCH;
+        const float *firstRow = grid + GRID_PITCH;
+        const float *lastRow = grid + HEIGHT * GRID_PITCH;
+        for (int x = 1; x <= WIDTH; x++) {
+            top[x] = lastRow[x];
+            bottom[x] = firstRow[x];
+        }
+        for (int y = 0; y < GRID_ROWS; y++) {
+            float *row = grid + y * GRID_PITCH;
+            row[0] = row[WIDTH];
+            row[WIDTH + 1] = row[1];
+        }
+    }
+
     // Spatial variation LUTs - precomputed once per frame/once at init instead
     // of re-evaluated per pixel (saves tens of thousands of trig calls per frame).
     static float sinXVar_LUT[WIDTH];    // per-frame: sinf(x*0.15 + t*0.3)
@@ -166,9 +189,12 @@ namespace synaptide {
             float totalEnergy = 0;
             int activePixels = 0;
             
-            for(int i = 0; i < NUM_LEDS; i++) {
-                totalEnergy += matrix[i];
-                if(matrix[i] > 0.1f) activePixels++;
+            for(int y = 0; y < HEIGHT; y++) {
+                const float* row = matrix + cell(0, y);
+                for(int x = 0; x < WIDTH; x++) {
+                    totalEnergy += row[x];
+                    if(row[x] > 0.1f) activePixels++;
+                }
             }
             
             // Weight both average energy and active pixel ratio
@@ -214,7 +240,8 @@ namespace synaptide {
             int boostCount = FL_MAX(5, NUM_LEDS / 120);
             
             for(int i = 0; i < boostCount; i++) {
-                int randI = random16() % NUM_LEDS;
+                int randN = random16() % NUM_LEDS;
+                int randI = cell(randN % WIDTH, randN / WIDTH);
                 float currentVal = matrix[randI];
                 // Medium boost - enough to sustain but not create geometric artifacts
                 float boost = 0.25f + (0.15f * randomFactor());
@@ -279,8 +306,7 @@ namespace synaptide {
 
     void tick(FrameTime frameTime);
 
-    //void drawMatrix(float *matrix) {
-    void drawMatrix(float *matrix, const uint16_t* activeMap) {
+    void drawMatrix(float *matrix) {
         // Hoist frame-constant values out of the per-pixel loop.
         const float brightnessScale = matrixScaler.getBrightnessScale();
         const float bloom4 = 4.0f * cBloomEdge;
@@ -289,11 +315,12 @@ namespace synaptide {
 
         for (int y = 0; y < HEIGHT; y++) {
             const int rowBase = y * WIDTH;
+            const float* row = matrix + cell(0, y);
             for (int x = 0; x < WIDTH; x++) {
-                // Single mapping lookup per pixel (was two: xyFunc + setPixel->xyFunc).
+                // Grid and canvas are both row-major; outputStage does the wiring
                 //const int i = xyFunc(x, y);
-                const uint16_t i = activeMap[rowBase + x];
-                const float val = matrix[i];
+                const uint16_t i = rowBase + x;
+                const float val = row[x];
 
                 // Polynomial approximations for sin/cos over val in [0,1].
                 // Reshaped vs the original cos≈1-v²/2, sin≈v-v³/6 to pull the
@@ -319,9 +346,7 @@ namespace synaptide {
                 const uint8_t rByte = static_cast<uint8_t>(FL_MAX(0.0f, FL_MIN(1.0f, r)) * 255.0f);
                 const uint8_t gByte = static_cast<uint8_t>(FL_MAX(0.0f, FL_MIN(1.0f, g)) * 255.0f);
                 const uint8_t bByte = static_cast<uint8_t>(FL_MAX(0.0f, FL_MIN(1.0f, b)) * 255.0f);
-                if (i < NUM_LEDS) {
-                    leds[i] = CRGB(rByte, gByte, bByte);
-                }
+                leds[i] = CRGB(rByte, gByte, bByte);
             }
         }
     }
@@ -333,7 +358,7 @@ namespace synaptide {
         
         for (int y = 0; y < HEIGHT; y++) {
             for (int x = 0; x < WIDTH; x++) {
-                const int i = xyFunc(x, y);
+                const int i = cell(x, y);
                 
                 // Base: mostly low energy (below ignition threshold)
                 float baseEnergy = 0.05f + (0.1f * randomFactor());
@@ -373,21 +398,12 @@ namespace synaptide {
                 matrix2[i] = maxSeedEnergy;
             }
         }
+        wrapHalo(matrix1);
+        wrapHalo(matrix2);
     }
 
     void tick(FrameTime frameTime) {
 
-        // Cache the active mapping table pointer once per frame (was: per-pixel
-        // xyFunc() call with switch on cMapping, ~10× per pixel in tick+draw).
-        const uint16_t* activeMap;
-        switch (cMapping) {
-            case 0:  activeMap = progTopDown;    break;
-            case 1:  activeMap = progBottomUp;   break;
-            case 2:  activeMap = serpTopDown;    break;
-            case 3:  activeMap = serpBottomUp;   break;
-            default: activeMap = progTopDown;    break;
-        }
-
         // Global-speed via skip-frame accumulator:
         //   cSynSpeed < 1 → sim steps happen less often than display frames
         //                   (e.g. 0.5 = every other frame)
@@ -453,16 +469,16 @@ namespace synaptide {
             for (int disturbances = 0; disturbances < 2; disturbances++) {
                 int randX = random16() % WIDTH;
                 int randY = random16() % HEIGHT;
-                //int randI = xyFunc(randX, randY);
-                int randI = activeMap[randY * WIDTH + randX];
-                if (randI >= 0 && randI < NUM_LEDS) {
-                    float currentVal = lastMatrix[randI];
-                    float perturbation = 0.05f + 0.15f * randomFactor();
-                    lastMatrix[randI] = FL_MIN(1.0f, currentVal + perturbation);
-                }
+                const int randI = cell(randX, randY);
+                float currentVal = lastMatrix[randI];
+                float perturbation = 0.05f + 0.15f * randomFactor();
+                lastMatrix[randI] = FL_MIN(1.0f, currentVal + perturbation);
             }
         }
 
+        // Halo of the source grid must match its (possibly perturbed) edges
+        wrapHalo(lastMatrix);
+
         // Energy accumulators — replaces the separate NUM_LEDS scan in the
         // EVERY_N_MILLISECONDS block below.
         float frameEnergySum = 0.0f;
@@ -470,11 +486,11 @@ namespace synaptide {
 
         PROFILE_START("syn_tick");
         for (int y = 0; y < HEIGHT; y++) {
-            const int rowBase = y * WIDTH;
+            const float* src = lastMatrix + cell(0, y);
+            float* dst = matrix + cell(0, y);
             for (int x = 0; x < WIDTH; x++) {
-                //const int i = xyFunc(x, y);
-                const uint16_t i = activeMap[rowBase + x];
-                const float lastValue = lastMatrix[i];
+                const float* c = src + x;
+                const float lastValue = *c;
 
                 // Varied decay to break synchronization
                 //float spatialVariation = 0.002f * fl::sinf(x * 0.15f + frameTime.t * 0.3f) * fl::cosf(y * 0.12f + frameTime.t * 0.2f);
@@ -482,7 +498,7 @@ namespace synaptide {
                 float decayRate = decayBase + cDecayChaos * randomFactor() + spatialVariation;
                 // Clamp decay rate to safe range
                 decayRate = FL_MAX(0.88f, FL_MIN(1.0f, decayRate));
-                matrix[i] = lastValue * decayRate;
+                float value = lastValue * decayRate;
 
                 // Diverse ignition thresholds — noise-driven so "easy ignition"
                 // zones drift organically instead of standing in sinusoidal cells.
@@ -499,15 +515,13 @@ namespace synaptide {
                     float n = 0;
 
                     for (int u = -1; u <= 1; u++) {
+                        const int nX = wrapX_LUT[x + 1 + u];
                         for (int v = -1; v <= 1; v++) {
                             if (u == 0 && v == 0) { continue; }
 
-                            int nX = (x + u + WIDTH) % WIDTH;
-                            int nY = (y + v + HEIGHT) % HEIGHT;
-
-                            //const int nI = xyFunc(nX, nY);
-                            const uint16_t nI = activeMap[nY * WIDTH + nX];
-                            const float nLastValue = lastMatrix[nI];
+                            // Halo makes every neighbor a fixed offset from c
+                            const float nLastValue = c[v * GRID_PITCH + u];
+                            const int nY = wrapY_LUT[y + 1 + v];
 
                             // Varied neighbor thresholds and influence to de-synchronize blooms
                             //float neighborThreshold = matrixScaler.getScaledNeighborBase() + cNeighborChaos * 0.5f + 0.01f * fl::sinf((nX + nY) * 0.3f);
@@ -516,25 +530,26 @@ namespace synaptide {
                                 n += 1;
                                 //float influence = matrixScaler.getScaledInfluenceBase() + cInfluenceChaos * 0.5f;
                                 float influence = influenceBase + cInfluenceChaos * randomFactor();
-                                matrix[i] += nLastValue * influence;
+                                value += nLastValue * influence;
                             }
                         }
                     }
 
                     if (n > 0) {
-                        matrix[i] *= 1.0f / n;
+                        value *= 1.0f / n;
                         // Additional safety clamp
-                        matrix[i] = FL_MIN(1.0f, matrix[i]);
+                        value = FL_MIN(1.0f, value);
                     }
                     // Ensure values stay in valid range
-                    matrix[i] = FL_MAX(0.0f, FL_MIN(1.0f, matrix[i]));
+                    value = FL_MAX(0.0f, FL_MIN(1.0f, value));
                 }
 
+                dst[x] = value;
+
                 // Accumulate energy stats from final pixel value (folded in to
                 // avoid a second pass over NUM_LEDS in the energy monitor).
-                const float finalVal = matrix[i];
-                frameEnergySum += finalVal;
-                if (finalVal > 0.1f) frameActivePixels++;
+                frameEnergySum += value;
+                if (value > 0.1f) frameActivePixels++;
             }
         }
         PROFILE_END();  // syn_tick
@@ -562,7 +577,7 @@ namespace synaptide {
 
         //drawMatrix(matrix);
         PROFILE_START("syn_draw");
-        drawMatrix(matrix, activeMap);
+        drawMatrix(matrix);
         PROFILE_END();
         //watermelonPlasma(frameTime);
 
@@ -600,6 +615,12 @@ namespace synaptide {
         for (int s = 0; s < WIDTH + HEIGHT; s++) {
             neighborSin_LUT[s] = fl::sinf(s * 0.3f);
         }
+        for (int x = 0; x < WIDTH + 2; x++) {
+            wrapX_LUT[x] = (uint8_t)((x - 1 + WIDTH) % WIDTH);
+        }
+        for (int y = 0; y < HEIGHT + 2; y++) {
+            wrapY_LUT[y] = (uint8_t)((y - 1 + HEIGHT) % HEIGHT);
+        }
 
         initMatrix();
     }
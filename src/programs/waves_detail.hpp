@@ -114,14 +114,8 @@ namespace waves {
 				}
 			}
 
-			switch(cMapping) {
-				case 0:	 ledNum = progTopDown[i]; break;
-				case 1:	 ledNum = progBottomUp[i]; break;
-				case 2:	 ledNum = serpTopDown[i]; break;
-				case 3:	 ledNum = serpBottomUp[i]; break;
-				//case 4:	 ledNum = vProgTopDown[i]; break;
-				//case 5:	 ledNum = vSerpTopDown[i]; break;
-			}
+			// Canvas order; outputStage applies the cMapping table
+			ledNum = i;
 
 			//EaseType ease_sat = getEaseType(cEaseSat);
        		//EaseType ease_lum = getEaseType(cEaseLum);
@@ -0,0 +1,185 @@
+#pragma once
+
+//========================================================================================
+// renderWorker — splits a render loop into two bands across both cores
+//
+// run(fn, ctx, count) cuts [0, count) into two bands. A worker task pinned to the
+// other core renders [0, split), the calling task (loopTask) renders [split, count),
+// and run() returns once both are done. Band functions must write disjoint pixels and
+// only read shared per-frame state (timers, LUTs, hoisted constants). Per-band
+// scratch is indexed by the `band` argument (0 = caller, 1 = worker).
+//
+// ESP32-S3/P4: FreeRTOS task at loop priority on the core loop() isn't using. That
+// core also runs the show task (showPipeline, prio 2) and the audio task (prio 3),
+// which preempt the worker, so the two bands do not get equal CPU and the speedup
+// is well short of 2x. With `adaptive` set, run() times both bands (dispatch ->
+// done, preemption included) and moves splitPercent toward the split at which
+// they finish together; splitPercent is then the measured worker share.
+// Host build: a std::thread, so the same split is exercised under hostRunner.
+//========================================================================================
+
+#include <stdint.h>
+
+#if defined(AURORA_HOST)
+    #include <thread>
+    #include <mutex>
+    #include <condition_variable>
+#else
+    #include "freertos/FreeRTOS.h"
+    #include "freertos/task.h"
+    #include "freertos/semphr.h"
+#endif
+
+namespace renderWorker {
+
+    typedef void (*BandFn)(void* ctx, int begin, int end, uint8_t band);
+
+    bool enabled = true;            // false = everything renders on the calling core
+    bool adaptive = true;           // rebalance splitPercent from measured band times
+    uint8_t splitPercent = 50;      // share of the range handed to the worker core
+
+    constexpr uint8_t MIN_SPLIT_PERCENT = 10;   // keep both bands measurable
+    constexpr uint8_t MAX_SPLIT_PERCENT = 90;
+
+    struct Job {
+        BandFn fn = nullptr;
+        void* ctx = nullptr;
+        int begin = 0;
+        int end = 0;
+    };
+
+    Job job;
+    bool started = false;
+
+    uint32_t dispatchUs = 0;                // when run() handed out the worker band
+    volatile uint32_t workerDoneUs = 0;     // when the worker finished it
+    float splitShare = 50.0f;               // smoothed splitPercent
+
+    //=====================================================================
+
+    #if defined(AURORA_HOST)
+
+        std::mutex jobMutex;
+        std::condition_variable jobCv;
+        bool jobPending = false;
+        bool jobDone = false;
+
+        void workerLoop() {
+            for (;;) {
+                std::unique_lock<std::mutex> lock(jobMutex);
+                jobCv.wait(lock, [] { return jobPending; });
+                jobPending = false;
+                const Job j = job;
+                lock.unlock();
+
+                j.fn(j.ctx, j.begin, j.end, 1);
+                workerDoneUs = micros();
+
+                lock.lock();
+                jobDone = true;
+                jobCv.notify_all();
+            }
+        }
+
+        bool startWorker() {
+            std::thread(workerLoop).detach();
+            return true;
+        }
+
+        void dispatch() {
+            {
+                std::lock_guard<std::mutex> lock(jobMutex);
+                jobDone = false;
+                jobPending = true;
+            }
+            jobCv.notify_all();
+        }
+
+        void waitDone() {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobCv.wait(lock, [] { return jobDone; });
+        }
+
+    #else
+
+        TaskHandle_t workerTask = nullptr;
+        SemaphoreHandle_t doneSem = nullptr;
+
+        void workerLoop(void*) {
+            for (;;) {
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+                job.fn(job.ctx, job.begin, job.end, 1);
+                workerDoneUs = micros();
+                xSemaphoreGive(doneSem);
+            }
+        }
+
+        bool startWorker() {
+            doneSem = xSemaphoreCreateBinary();
+            if (!doneSem) return false;
+            // Same priority as loopTask; the show/audio tasks and NimBLE's host
+            // task on that core preempt it (see rebalance())
+            const BaseType_t otherCore = 1 - xPortGetCoreID();
+            return xTaskCreatePinnedToCore(workerLoop, "renderWorker", 8192, nullptr,
+                                           1, &workerTask, otherCore) == pdPASS;
+        }
+
+        void dispatch() {
+            xTaskNotifyGive(workerTask);
+        }
+
+        void waitDone() {
+            xSemaphoreTake(doneSem, portMAX_DELAY);
+        }
+
+    #endif
+
+    //=====================================================================
+
+    // Per-column rate of each band -> the worker share that equalises their
+    // finish times, smoothed so one preempted frame doesn't swing the split
+    void rebalance(int split, int count, uint32_t workerUs, uint32_t callerUs) {
+        if (workerUs == 0 || callerUs == 0) return;
+        const float workerRate = split / (float)workerUs;
+        const float callerRate = (count - split) / (float)callerUs;
+        const float target = 100.0f * workerRate / (workerRate + callerRate);
+        splitShare += 0.1f * (target - splitShare);
+        splitShare = fl::clamp(splitShare, (float)MIN_SPLIT_PERCENT, (float)MAX_SPLIT_PERCENT);
+        splitPercent = (uint8_t)(splitShare + 0.5f);
+    }
+
+    void run(BandFn fn, void* ctx, int count) {
+
+        if (enabled && !started) {
+            started = startWorker();
+            if (!started) {
+                enabled = false;
+                Serial.println("renderWorker: could not start worker task, rendering single-core");
+            }
+        }
+
+        if (!enabled || count < 2) {
+            fn(ctx, 0, count, 0);
+            return;
+        }
+
+        const int split = count * splitPercent / 100;
+        job.fn = fn;
+        job.ctx = ctx;
+        job.begin = 0;
+        job.end = split;
+        dispatchUs = micros();
+        dispatch();
+
+        fn(ctx, split, count, 0);
+        const uint32_t callerUs = micros() - dispatchUs;
+        waitDone();
+
+        if (adaptive && split > 0 && split < count) {
+            rebalance(split, count, workerDoneUs - dispatchUs, callerUs);
+        } else if (!adaptive) {
+            splitShare = splitPercent;
+        }
+    }
+
+} // namespace renderWorker
@@ -0,0 +1,137 @@
+#pragma once
+
+//========================================================================================
+// showPipeline — overlaps FastLED.show() for frame N with rendering of frame N+1
+//
+// The canvas (leds[]) and outputStage::frame are the two framebuffers. loop() renders
+// into the canvas, and present() hands it off:
+//   1. wait until the show task has finished sending the previous frame[]
+//   2. outputStage::render(): canvas -> frame[] (one pass, well under a millisecond)
+//   3. wake the show task, which calls FastLED.show() on the other core
+// present() then returns, and loop() goes on to render the next frame while the
+// strips are still being written. frame[] is never written while it is in flight,
+// and the canvas is never read by the show task, so neither side can tear.
+//
+// enabled = false (or a failed task start) falls back to render + show inline.
+// The host build has no loop() or strips, so there it is always inline.
+//
+// latencyMs tracks present() -> frame fully sent, for the AV beat prediction.
+//========================================================================================
+
+#include <stdint.h>
+
+#if !defined(AURORA_HOST)
+    #include "freertos/FreeRTOS.h"
+    #include "freertos/task.h"
+    #include "freertos/semphr.h"
+#endif
+
+namespace showPipeline {
+
+    bool enabled = true;
+    bool started = false;
+
+    volatile uint32_t presentMs = 0;        // when the frame now in flight was presented
+    volatile float latencyMs = 0.0f;        // present() -> show() finished (EMA)
+
+    inline void noteShown() {
+        const uint32_t dt = fl::millis() - presentMs;
+        if (dt < 1000) latencyMs = latencyMs + 0.1f * (dt - latencyMs);
+    }
+
+    //=====================================================================
+
+    #if defined(AURORA_HOST)
+
+        bool startTask() { return false; }
+        void waitIdle() {}
+        void markIdle() {}
+        void kick() {}
+
+    #else
+
+        TaskHandle_t showTask = nullptr;
+        SemaphoreHandle_t idleSem = nullptr;    // given while frame[] is not being sent
+
+        void showLoop(void*) {
+            for (;;) {
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+                FastLED.show();
+                noteShown();
+                xSemaphoreGive(idleSem);
+            }
+        }
+
+        bool startTask() {
+            idleSem = xSemaphoreCreateBinary();
+            if (!idleSem) return false;
+            xSemaphoreGive(idleSem);
+            // Above loop priority so a finished frame goes out right away; show()
+            // mostly blocks on the driver, which leaves the core to renderWorker
+            const BaseType_t otherCore = 1 - xPortGetCoreID();
+            return xTaskCreatePinnedToCore(showLoop, "ledShow", 4096, nullptr,
+                                           2, &showTask, otherCore) == pdPASS;
+        }
+
+        void waitIdle() { xSemaphoreTake(idleSem, portMAX_DELAY); }
+        void markIdle() { xSemaphoreGive(idleSem); }
+        void kick() { xTaskNotifyGive(showTask); }
+
+    #endif
+
+    //=====================================================================
+
+    void present(const fl::CRGB* canvas, uint8_t brightness) {
+
+        const uint32_t calledMs = fl::millis();
+
+        if (enabled && !started) {
+            started = startTask();
+            if (!started) {
+                enabled = false;
+                #if !defined(AURORA_HOST)
+                    Serial.println("showPipeline: could not start show task, showing inline");
+                #endif
+            }
+        }
+
+        // Once started, frame[] ownership always goes through idleSem, even when
+        // enabled was switched off later and a frame may still be in flight
+        if (started) {
+            PROFILE_START("led_wait");
+            waitIdle();
+            PROFILE_END();
+        }
+
+        PROFILE_START("led_output");
+        outputStage::render(canvas, brightness);
+        PROFILE_END();
+
+        presentMs = calledMs;
+
+        if (started && enabled) {
+            kick();
+            return;
+        }
+
+        PROFILE_START("led_show");
+        FastLED.show();
+        PROFILE_END();
+        noteShown();
+
+        if (started) markIdle();
+    }
+
+    // Fixed frame pacing for programs that used FastLED.delay(). That helper
+    // calls FastLED.show() from loop() in a spin, racing the show task on the
+    // same controllers and frame[]; this only gives the core away. The host
+    // runner owns the clock, so there it does nothing.
+    inline void pace(uint32_t ms) {
+        #if defined(AURORA_HOST)
+            (void)ms;
+        #else
+            vTaskDelay(pdMS_TO_TICKS(ms));
+        #endif
+    }
+
+} // namespace showPipeline